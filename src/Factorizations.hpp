@@ -0,0 +1,598 @@
+#ifndef FACTORIZATIONS_H
+#define FACTORIZATIONS_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+#include "Householder.hpp"
+
+// Cholesky and QR factorizations of Matrix<double>.
+//
+// Both are blocked right-looking algorithms: a panel of `blockSize`
+// columns is factored with the unblocked kernel, then the trailing
+// matrix is updated with one matrix-matrix operation per panel instead
+// of one rank-1 update per column. A blockSize of at least the matrix
+// size runs the plain unblocked algorithm. Rows are stored contiguously,
+// so every kernel is written as dot products or axpys along rows, and
+// trailing updates are split between `threads` workers (0 = one worker
+// per hardware thread).
+
+namespace factorization_detail
+{
+    using Rows = std::vector<std::vector<double>>;
+
+    // Minimum rows per worker for trailing updates
+    constexpr int minRowsPerWorker = 16;
+
+    inline double dot(const double *x, const double *y, int n)
+    {
+        double s = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            s += x[i] * y[i];
+        }
+        return s;
+    }
+
+    inline Rows toRows(const Matrix<double> &a)
+    {
+        Rows rows(a.rows());
+        for (int i = 0; i < a.rows(); ++i)
+        {
+            rows[i] = a[i];
+        }
+        return rows;
+    }
+
+    inline Matrix<double> toMatrix(Rows rows)
+    {
+        return Matrix<double>(std::move(rows));
+    }
+}
+
+// A = L * L^T for a symmetric positive definite A. Only the lower
+// triangle of A is read.
+class Cholesky
+{
+private:
+    std::vector<std::vector<double>> l;
+
+    // Unblocked (Cholesky-Crout) factorization of l[k .. k+kb) in place
+    void factorDiagonalBlock(int k, int kb)
+    {
+        for (int j = k; j < k + kb; ++j)
+        {
+            double *lj = l[j].data();
+            double pivot = lj[j] - factorization_detail::dot(lj + k, lj + k, j - k);
+            if (!(pivot > 0))
+            {
+                throw std::runtime_error("Matrix must be positive definite.");
+            }
+            lj[j] = std::sqrt(pivot);
+            for (int i = j + 1; i < k + kb; ++i)
+            {
+                double *li = l[i].data();
+                li[j] = (li[j] - factorization_detail::dot(li + k, lj + k, j - k)) / lj[j];
+            }
+        }
+    }
+
+public:
+    explicit Cholesky(const Matrix<double> &a, int blockSize = 64, int threads = 0)
+    {
+        if (a.rows() != a.cols())
+        {
+            throw std::runtime_error("Matrix must be square.");
+        }
+        const int n = a.rows();
+        const int nb = std::max(blockSize, 1);
+        l.assign(n, std::vector<double>(n));
+        for (int i = 0; i < n; ++i)
+        {
+            std::copy(a[i].begin(), a[i].begin() + i + 1, l[i].begin());
+        }
+
+        for (int k = 0; k < n; k += nb)
+        {
+            const int kb = std::min(nb, n - k), end = k + kb;
+            factorDiagonalBlock(k, kb);
+
+            // Panel: L21 = A21 * L11^-T, one forward substitution per row
+            parallelFor(
+                end, n, [&](int begin, int stop, int)
+                {
+                    for (int i = begin; i < stop; ++i)
+                    {
+                        double *li = l[i].data();
+                        for (int j = k; j < end; ++j)
+                        {
+                            const double *lj = l[j].data();
+                            li[j] = (li[j] - factorization_detail::dot(li + k, lj + k, j - k)) / lj[j];
+                        }
+                    } },
+                threads, factorization_detail::minRowsPerWorker);
+
+            // Trailing update of the lower triangle: A22 -= L21 * L21^T.
+            // Row i costs i - end dot products, so rows are dealt to the
+            // workers round-robin to balance the triangle.
+            const int workers = workerCount(end, n, threads, factorization_detail::minRowsPerWorker);
+            parallelFor(
+                0, workers, [&](int begin, int stop, int)
+                {
+                    for (int w = begin; w < stop; ++w)
+                    {
+                        for (int i = end + w; i < n; i += workers)
+                        {
+                            double *li = l[i].data();
+                            for (int j = end; j <= i; ++j)
+                            {
+                                li[j] -= factorization_detail::dot(li + k, l[j].data() + k, kb);
+                            }
+                        }
+                    } },
+                workers);
+        }
+    }
+
+    int size() const { return static_cast<int>(l.size()); }
+
+    // Lower triangular factor
+    Matrix<double> L() const { return factorization_detail::toMatrix(l); }
+
+    // Solves A * x = b
+    std::vector<double> solve(const std::vector<double> &b) const
+    {
+        const int n = size();
+        if (static_cast<int>(b.size()) != n)
+        {
+            throw std::runtime_error("Right-hand side must have as many rows as the matrix.");
+        }
+        std::vector<double> x = b;
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] = (x[i] - factorization_detail::dot(l[i].data(), x.data(), i)) / l[i][i];
+        }
+        // Back substitution with L^T, column-oriented so that L is read by rows
+        for (int i = n - 1; i >= 0; --i)
+        {
+            x[i] /= l[i][i];
+            const double *li = l[i].data();
+            for (int j = 0; j < i; ++j)
+            {
+                x[j] -= li[j] * x[i];
+            }
+        }
+        return x;
+    }
+
+    // Solves A * X = B for every column of B
+    Matrix<double> solve(const Matrix<double> &b, int threads = 0) const
+    {
+        const int n = size();
+        if (b.rows() != n)
+        {
+            throw std::runtime_error("Right-hand side must have as many rows as the matrix.");
+        }
+        const int p = b.cols();
+        factorization_detail::Rows x = factorization_detail::toRows(b);
+        // Row i of X is a combination of earlier rows, so the columns of B
+        // are split between the workers
+        parallelFor(
+            0, p, [&](int c0, int c1, int)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    double *xi = x[i].data();
+                    for (int j = 0; j < i; ++j)
+                    {
+                        const double *xj = x[j].data();
+                        double lij = l[i][j];
+                        for (int c = c0; c < c1; ++c)
+                        {
+                            xi[c] -= lij * xj[c];
+                        }
+                    }
+                    for (int c = c0; c < c1; ++c)
+                    {
+                        xi[c] /= l[i][i];
+                    }
+                }
+                for (int i = n - 1; i >= 0; --i)
+                {
+                    double *xi = x[i].data();
+                    for (int c = c0; c < c1; ++c)
+                    {
+                        xi[c] /= l[i][i];
+                    }
+                    for (int j = 0; j < i; ++j)
+                    {
+                        double *xj = x[j].data();
+                        double lij = l[i][j];
+                        for (int c = c0; c < c1; ++c)
+                        {
+                            xj[c] -= lij * xi[c];
+                        }
+                    }
+                } },
+            threads, 8);
+        return factorization_detail::toMatrix(std::move(x));
+    }
+
+    double determinant() const
+    {
+        double det = 1;
+        for (int i = 0; i < size(); ++i)
+        {
+            det *= l[i][i] * l[i][i];
+        }
+        return det;
+    }
+};
+
+// A = Q * R by Householder reflections. Panels of reflectors are
+// aggregated into the compact WY form I - V * T * V^T (LAPACK dlarft)
+// and applied to the trailing matrix as two matrix products.
+class QR
+{
+private:
+    // R on and above the diagonal, reflector vectors (without their unit
+    // leading entry) below it
+    std::vector<std::vector<double>> qr;
+    std::vector<double> tau;
+    int m = 0, n = 0;
+
+    // Width of the column tiles used when applying a block reflector
+    static constexpr int columnTile = 64;
+
+    // Unblocked factorization of columns [k, end), applying each reflector
+    // to the remaining columns of the panel only
+    void factorPanel(int k, int end, int threads)
+    {
+        std::vector<double> column(m), w(n);
+        for (int j = k; j < end; ++j)
+        {
+            for (int i = j; i < m; ++i)
+            {
+                column[i - j] = qr[i][j];
+            }
+            Householder h = makeHouseholder(column.data(), m - j);
+            tau[j] = h.tau;
+            qr[j][j] = h.beta;
+            for (int i = j + 1; i < m; ++i)
+            {
+                qr[i][j] = h.v[i - j];
+            }
+            if (h.tau == 0 || j + 1 == end)
+            {
+                continue;
+            }
+            // Columns (j, end) -= tau * v * (v^T * A), accumulated by rows
+            std::fill(w.begin() + j + 1, w.begin() + end, 0.0);
+            for (int i = j; i < m; ++i)
+            {
+                const double *row = qr[i].data();
+                double vi = h.tau * h.v[i - j];
+                for (int c = j + 1; c < end; ++c)
+                {
+                    w[c] += vi * row[c];
+                }
+            }
+            parallelFor(
+                j, m, [&](int begin, int stop, int)
+                {
+                    for (int i = begin; i < stop; ++i)
+                    {
+                        double *row = qr[i].data();
+                        double vi = h.v[i - j];
+                        for (int c = j + 1; c < end; ++c)
+                        {
+                            row[c] -= vi * w[c];
+                        }
+                    } },
+                threads, std::max(factorization_detail::minRowsPerWorker, 4096 / std::max(end - j, 1)));
+        }
+    }
+
+    // Applies (I - V * T * V^T)^T to columns [end, n) of rows [k, m)
+    void applyBlockReflector(int k, int end, int threads)
+    {
+        const int kb = end - k, rows = m - k, cols = n - end;
+        if (cols <= 0)
+        {
+            return;
+        }
+        // V as rows: v[r][j] is entry k + r of reflector k + j
+        factorization_detail::Rows v(rows, std::vector<double>(kb));
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int j = 0; j < kb; ++j)
+            {
+                int i = k + r, c = k + j;
+                v[r][j] = i == c ? 1 : (i > c ? qr[i][c] : 0);
+            }
+        }
+        // T is upper triangular with T(0:j, j) = -tau_j * T(0:j, 0:j) * V(:, 0:j)^T * v_j
+        factorization_detail::Rows t(kb, std::vector<double>(kb));
+        std::vector<double> vtv(kb);
+        for (int j = 0; j < kb; ++j)
+        {
+            std::fill(vtv.begin(), vtv.end(), 0.0);
+            for (int r = j; r < rows; ++r)
+            {
+                for (int p = 0; p < j; ++p)
+                {
+                    vtv[p] += v[r][p] * v[r][j];
+                }
+            }
+            for (int p = 0; p < j; ++p)
+            {
+                double s = 0;
+                for (int q = p; q < j; ++q)
+                {
+                    s += t[p][q] * vtv[q];
+                }
+                t[p][j] = -tau[k + j] * s;
+            }
+            t[j][j] = tau[k + j];
+        }
+
+        // W = V^T * A2, then W = T^T * W, then A2 -= V * W. The trailing
+        // columns are processed in tiles so that the tile of W stays in
+        // cache while the rows of V and A2 stream past it, and the tiles
+        // are split between the workers. Four reflectors are handled per
+        // pass so each row segment of A2 is loaded once per four updates.
+        const int tiles = (cols + columnTile - 1) / columnTile;
+        parallelFor(
+            0, tiles, [&](int tile0, int tile1, int)
+            {
+                std::vector<double> w(kb * columnTile), column(kb);
+                for (int tile = tile0; tile < tile1; ++tile)
+                {
+                    const int c0 = tile * columnTile, width = std::min(columnTile, cols - c0);
+                    std::fill(w.begin(), w.end(), 0.0);
+                    for (int r = 0; r < rows; ++r)
+                    {
+                        const double *a = qr[k + r].data() + end + c0;
+                        const double *vr = v[r].data();
+                        const int jmax = std::min(r + 1, kb);
+                        int j = 0;
+                        for (; j + 4 <= jmax; j += 4)
+                        {
+                            double *w0 = &w[j * width], *w1 = w0 + width, *w2 = w1 + width, *w3 = w2 + width;
+                            for (int c = 0; c < width; ++c)
+                            {
+                                double x = a[c];
+                                w0[c] += vr[j] * x;
+                                w1[c] += vr[j + 1] * x;
+                                w2[c] += vr[j + 2] * x;
+                                w3[c] += vr[j + 3] * x;
+                            }
+                        }
+                        for (; j < jmax; ++j)
+                        {
+                            double *wj = &w[j * width];
+                            for (int c = 0; c < width; ++c)
+                            {
+                                wj[c] += vr[j] * a[c];
+                            }
+                        }
+                    }
+                    for (int c = 0; c < width; ++c)
+                    {
+                        for (int j = kb - 1; j >= 0; --j)
+                        {
+                            double s = 0;
+                            for (int p = 0; p <= j; ++p)
+                            {
+                                s += t[p][j] * w[p * width + c];
+                            }
+                            column[j] = s;
+                        }
+                        for (int j = 0; j < kb; ++j)
+                        {
+                            w[j * width + c] = column[j];
+                        }
+                    }
+                    for (int r = 0; r < rows; ++r)
+                    {
+                        double *a = qr[k + r].data() + end + c0;
+                        const double *vr = v[r].data();
+                        const int jmax = std::min(r + 1, kb);
+                        int j = 0;
+                        for (; j + 4 <= jmax; j += 4)
+                        {
+                            const double *w0 = &w[j * width], *w1 = w0 + width, *w2 = w1 + width, *w3 = w2 + width;
+                            for (int c = 0; c < width; ++c)
+                            {
+                                a[c] -= vr[j] * w0[c] + vr[j + 1] * w1[c] + vr[j + 2] * w2[c] + vr[j + 3] * w3[c];
+                            }
+                        }
+                        for (; j < jmax; ++j)
+                        {
+                            const double *wj = &w[j * width];
+                            for (int c = 0; c < width; ++c)
+                            {
+                                a[c] -= vr[j] * wj[c];
+                            }
+                        }
+                    }
+                } },
+            threads, 1);
+    }
+
+    // Applies Q^T to the rows of x (m rows, any number of columns)
+    void applyQt(factorization_detail::Rows &x) const
+    {
+        const int p = x.empty() ? 0 : static_cast<int>(x[0].size());
+        std::vector<double> w(p);
+        for (int j = 0; j < std::min(m, n); ++j)
+        {
+            if (tau[j] == 0)
+            {
+                continue;
+            }
+            std::fill(w.begin(), w.end(), 0.0);
+            for (int i = j; i < m; ++i)
+            {
+                double vi = i == j ? 1 : qr[i][j];
+                for (int c = 0; c < p; ++c)
+                {
+                    w[c] += vi * x[i][c];
+                }
+            }
+            for (int i = j; i < m; ++i)
+            {
+                double vi = tau[j] * (i == j ? 1 : qr[i][j]);
+                for (int c = 0; c < p; ++c)
+                {
+                    x[i][c] -= vi * w[c];
+                }
+            }
+        }
+    }
+
+public:
+    explicit QR(const Matrix<double> &a, int blockSize = 32, int threads = 0)
+        : qr(factorization_detail::toRows(a)), tau(std::min(a.rows(), a.cols())), m(a.rows()), n(a.cols())
+    {
+        const int nb = std::max(blockSize, 1);
+        const int steps = std::min(m, n);
+        for (int k = 0; k < steps; k += nb)
+        {
+            const int end = std::min(k + nb, steps);
+            factorPanel(k, end, threads);
+            applyBlockReflector(k, end, threads);
+        }
+    }
+
+    // Upper triangular (trapezoidal) factor, min(m, n) x n
+    Matrix<double> R() const
+    {
+        const int r = std::min(m, n);
+        Matrix<double> out(r, n);
+        for (int i = 0; i < r; ++i)
+        {
+            for (int j = i; j < n; ++j)
+            {
+                out[i][j] = qr[i][j];
+            }
+        }
+        return out;
+    }
+
+    // Orthonormal factor with min(m, n) columns
+    Matrix<double> Q() const
+    {
+        const int r = std::min(m, n);
+        factorization_detail::Rows q(m, std::vector<double>(r));
+        for (int i = 0; i < r; ++i)
+        {
+            q[i][i] = 1;
+        }
+        // Q = H_0 * ... * H_{r-1} applied to the first r columns of I
+        std::vector<double> w(r);
+        for (int j = r - 1; j >= 0; --j)
+        {
+            if (tau[j] == 0)
+            {
+                continue;
+            }
+            std::fill(w.begin(), w.end(), 0.0);
+            for (int i = j; i < m; ++i)
+            {
+                double vi = i == j ? 1 : qr[i][j];
+                for (int c = j; c < r; ++c)
+                {
+                    w[c] += vi * q[i][c];
+                }
+            }
+            for (int i = j; i < m; ++i)
+            {
+                double vi = tau[j] * (i == j ? 1 : qr[i][j]);
+                for (int c = j; c < r; ++c)
+                {
+                    q[i][c] -= vi * w[c];
+                }
+            }
+        }
+        return factorization_detail::toMatrix(std::move(q));
+    }
+
+    // Minimizes ||A * X - B|| column by column; requires rows >= cols and
+    // full column rank
+    Matrix<double> leastSquares(const Matrix<double> &b) const
+    {
+        if (m < n)
+        {
+            throw std::runtime_error("Least squares requires at least as many rows as columns.");
+        }
+        if (b.rows() != m)
+        {
+            throw std::runtime_error("Right-hand side must have as many rows as the matrix.");
+        }
+        factorization_detail::Rows x = factorization_detail::toRows(b);
+        applyQt(x);
+        x.resize(n);
+        const int p = b.cols();
+        for (int i = n - 1; i >= 0; --i)
+        {
+            if (qr[i][i] == 0)
+            {
+                throw std::runtime_error("Matrix is rank deficient.");
+            }
+            for (int j = i + 1; j < n; ++j)
+            {
+                double rij = qr[i][j];
+                for (int c = 0; c < p; ++c)
+                {
+                    x[i][c] -= rij * x[j][c];
+                }
+            }
+            for (int c = 0; c < p; ++c)
+            {
+                x[i][c] /= qr[i][i];
+            }
+        }
+        return factorization_detail::toMatrix(std::move(x));
+    }
+
+    std::vector<double> leastSquares(const std::vector<double> &b) const
+    {
+        std::vector<std::vector<double>> column(b.size());
+        for (std::size_t i = 0; i < b.size(); ++i)
+        {
+            column[i] = {b[i]};
+        }
+        Matrix<double> x = leastSquares(Matrix<double>(column));
+        std::vector<double> out(n);
+        for (int i = 0; i < n; ++i)
+        {
+            out[i] = x[i][0];
+        }
+        return out;
+    }
+
+    // Solves the square system A * x = b
+    std::vector<double> solve(const std::vector<double> &b) const
+    {
+        if (m != n)
+        {
+            throw std::runtime_error("Matrix must be square.");
+        }
+        return leastSquares(b);
+    }
+
+    Matrix<double> solve(const Matrix<double> &b) const
+    {
+        if (m != n)
+        {
+            throw std::runtime_error("Matrix must be square.");
+        }
+        return leastSquares(b);
+    }
+};
+
+#endif // FACTORIZATIONS_H
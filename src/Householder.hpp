@@ -0,0 +1,82 @@
+#ifndef HOUSEHOLDER_H
+#define HOUSEHOLDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Elementary reflector H = I - tau * v * v^T with v[0] = 1 such that
+// H * x = beta * e1 for the vector x it was generated from
+struct Householder
+{
+    std::vector<double> v;
+    double tau = 0;
+    double beta = 0;
+};
+
+// Generates the reflector for x[0 .. n-1] (LAPACK dlarfg convention).
+// tau is 0 and H is the identity when x is already a multiple of e1.
+inline Householder makeHouseholder(const double *x, int n)
+{
+    Householder h;
+    h.v.assign(x, x + n);
+    h.beta = n > 0 ? x[0] : 0;
+    if (n == 0)
+    {
+        return h;
+    }
+    h.v[0] = 1;
+    // Scale by the largest entry so the sum of squares cannot overflow
+    double largest = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        largest = std::max(largest, std::fabs(x[i]));
+    }
+    double tailNorm = 0;
+    if (largest > 0)
+    {
+        double squares = 0;
+        for (int i = 1; i < n; ++i)
+        {
+            double t = x[i] / largest;
+            squares += t * t;
+        }
+        tailNorm = largest * std::sqrt(squares);
+    }
+    if (tailNorm == 0)
+    {
+        return h;
+    }
+    double alpha = x[0];
+    h.beta = -std::copysign(std::hypot(alpha, tailNorm), alpha);
+    h.tau = (h.beta - alpha) / h.beta;
+    double scale = 1 / (alpha - h.beta);
+    for (int i = 1; i < n; ++i)
+    {
+        h.v[i] *= scale;
+    }
+    return h;
+}
+
+// Applies H to the contiguous vector y[0 .. v.size()-1] in place
+inline void applyHouseholder(const Householder &h, double *y)
+{
+    if (h.tau == 0)
+    {
+        return;
+    }
+    const int n = static_cast<int>(h.v.size());
+    const double *v = h.v.data();
+    double s = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        s += v[i] * y[i];
+    }
+    s *= h.tau;
+    for (int i = 0; i < n; ++i)
+    {
+        y[i] -= s * v[i];
+    }
+}
+
+#endif // HOUSEHOLDER_H
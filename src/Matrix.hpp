@@ -1,12 +1,15 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <iomanip>
 #include <stdexcept>
 #include <type_traits>
 #include <cmath>
+#include "Parallel.hpp"
+#include "TextFormat.hpp"
 
 // Concept for Matrix Element
 template <typename T>
@@ -31,14 +34,14 @@ public:
     // Constructors
     Matrix() {} // Default constructor
 
-    Matrix(int rows, int cols) : data(rows, std::vector<T>(cols)) {} // Constructor with specified rows and columns
+    Matrix(int rows, int cols) : data(rows) { allocateRows(data, cols); } // Constructor with specified rows and columns (placed per Numa.hpp)
 
     Matrix(std::vector<std::vector<T>> input_data) : data(input_data) {} // Constructor with initial data
 
     // Accessors
     int rows() const { return data.size(); }
 
-    int cols() const { return data[0].size(); }
+    int cols() const { return data.empty() ? 0 : data[0].size(); }
 
     // Element access operators
     std::vector<T> &operator[](int index) { return data[index]; }
@@ -87,16 +90,30 @@ public:
             throw std::runtime_error("The number of columns in the first matrix must be equal to the number of rows in the second matrix.");
         }
         Matrix<T> result(rows(), other.cols());
-        for (int i = 0; i < rows(); ++i)
-        {
-            for (int j = 0; j < other.cols(); ++j)
+        // Large products split the rows between all default workers in the
+        // chunks that pinned first-touch allocation uses (see Numa.hpp), so
+        // each worker writes rows on its own node. The i-k-j order walks
+        // rows of `other` contiguously and still adds the k terms of every
+        // element in ascending order.
+        const int inner = cols(), outer = other.cols();
+        const long long work = static_cast<long long>(inner) * outer;
+        parallelFor(
+            0, rows(), [&](int begin, int end, int)
             {
-                for (int k = 0; k < cols(); ++k)
+                for (int i = begin; i < end; ++i)
                 {
-                    result[i][j] += data[i][k] * other[k][j];
-                }
-            }
-        }
+                    T *out = result[i].data();
+                    for (int k = 0; k < inner; ++k)
+                    {
+                        const T a = data[i][k];
+                        const T *b = other[k].data();
+                        for (int j = 0; j < outer; ++j)
+                        {
+                            out[j] += a * b[j];
+                        }
+                    }
+                } },
+            0, static_cast<int>(std::max<long long>(1, (1 << 18) / std::max<long long>(work, 1))));
         return result;
     }
 
@@ -224,13 +241,24 @@ public:
     // Output operator
     friend std::ostream &operator<<(std::ostream &os, const Matrix<T> &matrix)
     {
-        for (int i = 0; i < matrix.rows(); ++i)
+        if constexpr (TextNumber<T>)
+        {
+            // Same text as below, formatted with std::to_chars (see TextFormat.hpp)
+            writeRows<T>(
+                os, matrix.rows(), matrix.cols(), [&](int i)
+                { return matrix[i].data(); },
+                WriteOptions{});
+        }
+        else
         {
-            for (int j = 0; j < matrix.cols(); ++j)
+            for (int i = 0; i < matrix.rows(); ++i)
             {
-                os << std::fixed << std::setprecision(2) << matrix[i][j] << " ";
+                for (int j = 0; j < matrix.cols(); ++j)
+                {
+                    os << std::fixed << std::setprecision(2) << matrix[i][j] << " ";
+                }
+                os << '\n';
             }
-            os << std::endl;
         }
         return os;
     }
@@ -0,0 +1,396 @@
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Matrix.hpp"
+#include "TextFormat.hpp"
+
+// Reading and writing matrices as text: whitespace-separated (the format
+// of operator<<), CSV and Matrix Market. Numbers go through
+// std::from_chars / std::to_chars, and large inputs and outputs are
+// parsed and formatted by several workers (see TextFormat.hpp).
+
+// Writes m in the format and precision given by options
+template <TextNumber T>
+void writeMatrix(std::ostream &os, const Matrix<T> &m, const WriteOptions &options = {})
+{
+    if (options.format != TextFormat::MatrixMarket)
+    {
+        writeRows<T>(os, m.rows(), m.cols(), [&](int i)
+                     { return m[i].data(); },
+                     options);
+        return;
+    }
+
+    // Matrix Market array format lists the entries column by column
+    std::string header = std::is_integral_v<T> ? "%%MatrixMarket matrix array integer general\n"
+                                               : "%%MatrixMarket matrix array real general\n";
+    header += std::to_string(m.rows()) + " " + std::to_string(m.cols()) + "\n";
+    os.write(header.data(), static_cast<std::streamsize>(header.size()));
+    const int minCols = std::max(1, text_detail::minElementsPerWorker / std::max(m.rows(), 1));
+    const int workers = workerCount(0, m.cols(), options.threads, minCols);
+    std::vector<std::string> buffers(workers);
+    parallelFor(
+        0, m.cols(), [&](int begin, int end, int w)
+        {
+            for (int j = begin; j < end; ++j)
+            {
+                for (int i = 0; i < m.rows(); ++i)
+                {
+                    appendNumber(buffers[w], m[i][j], options.precision);
+                    buffers[w] += '\n';
+                }
+            } },
+        workers, minCols);
+    for (const std::string &buffer : buffers)
+    {
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+}
+
+template <TextNumber T>
+std::string formatMatrix(const Matrix<T> &m, const WriteOptions &options = {})
+{
+    std::ostringstream out;
+    writeMatrix(out, m, options);
+    return out.str();
+}
+
+// Parses rows * cols row-major elements separated by whitespace or commas
+template <TextNumber T>
+Matrix<T> parseMatrix(std::string_view text, int rows, int cols, int threads = 0)
+{
+    Matrix<T> m(rows, cols);
+    parseTokens<T>(
+        text, static_cast<std::size_t>(rows) * cols, [&](std::size_t index, T value)
+        { m[index / cols][index % cols] = value; },
+        threads);
+    return m;
+}
+
+namespace text_detail
+{
+    // Access to the get area of any stream buffer: pointers to the
+    // protected members, taken through a derived class, apply to a base
+    struct GetArea : std::streambuf
+    {
+        static char *begin(std::streambuf *b) { return (b->*&GetArea::gptr)(); }
+        static char *end(std::streambuf *b) { return (b->*&GetArea::egptr)(); }
+        static void advance(std::streambuf *b, std::ptrdiff_t n) { (b->*&GetArea::gbump)(static_cast<int>(n)); }
+    };
+}
+
+// Reads exactly rows * cols elements from the stream, leaving anything
+// after the last element unread so the stream can be used for further
+// input. The buffered text is scanned and copied a block at a time, then
+// parsed in parallel.
+template <TextNumber T>
+Matrix<T> readMatrix(std::istream &is, int rows, int cols, int threads = 0)
+{
+    const std::size_t expected = static_cast<std::size_t>(rows) * cols;
+    std::string text;
+    std::streambuf *buffer = is.rdbuf();
+    std::size_t tokens = 0;
+    bool inToken = false, done = expected == 0;
+
+    // Scans [first, last) and returns where the matrix ends (the separator
+    // after its last element), or last if it continues
+    auto scan = [&](const char *first, const char *last)
+    {
+        // Count token starts without branching; only the block holding
+        // the end of the matrix needs the exact scan below
+        std::size_t starts = 0;
+        bool in = inToken;
+        for (const char *p = first; p < last; ++p)
+        {
+            bool token = !isSeparator(*p);
+            starts += token && !in;
+            in = token;
+        }
+        if (tokens + starts < expected || (tokens + starts == expected && in))
+        {
+            tokens += starts;
+            inToken = in;
+            return last;
+        }
+        for (const char *p = first; p < last; ++p)
+        {
+            if (isSeparator(*p))
+            {
+                if (inToken && tokens == expected)
+                {
+                    done = true;
+                    return p;
+                }
+                inToken = false;
+            }
+            else if (!inToken)
+            {
+                inToken = true;
+                ++tokens;
+            }
+        }
+        return last;
+    };
+
+    while (!done)
+    {
+        int c = buffer->sgetc();
+        if (c == std::char_traits<char>::eof())
+        {
+            break;
+        }
+        const char *first = text_detail::GetArea::begin(buffer);
+        const char *last = text_detail::GetArea::end(buffer);
+        if (first == last)
+        {
+            // Unbuffered stream: one character at a time
+            char ch = static_cast<char>(c);
+            if (scan(&ch, &ch + 1) == &ch + 1)
+            {
+                text += ch;
+                buffer->sbumpc();
+            }
+            continue;
+        }
+        const char *stop = scan(first, last);
+        text.append(first, stop);
+        text_detail::GetArea::advance(buffer, stop - first);
+    }
+    if (tokens < expected)
+    {
+        is.setstate(std::ios::eofbit | std::ios::failbit);
+        throw std::runtime_error("Expected " + std::to_string(expected) + " matrix elements, found " +
+                                 std::to_string(tokens) + ".");
+    }
+    return parseMatrix<T>(text, rows, cols, threads);
+}
+
+// Parses CSV text. Blank lines are skipped; every other line must have
+// the same number of comma-separated fields as the first, and no field
+// may be empty.
+template <TextNumber T>
+Matrix<T> parseCsv(std::string_view text, int threads = 0)
+{
+    int rows = 0, cols = 0, line = 0;
+    std::size_t start = 0;
+    while (start < text.size())
+    {
+        std::size_t end = std::min(text.find('\n', start), text.size());
+        std::string_view current = text.substr(start, end - start);
+        start = end + 1;
+        ++line;
+        if (current.find_first_not_of(" \t\r\v\f") == std::string_view::npos)
+        {
+            continue;
+        }
+        int fields = 0;
+        for (std::size_t pos = 0;;)
+        {
+            std::size_t comma = std::min(current.find(',', pos), current.size());
+            std::string_view field = current.substr(pos, comma - pos);
+            std::size_t first = field.find_first_not_of(" \t\r\v\f");
+            if (first == std::string_view::npos)
+            {
+                throw std::runtime_error("Empty field in CSV line " + std::to_string(line) + ".");
+            }
+            field = field.substr(first, field.find_last_not_of(" \t\r\v\f") + 1 - first);
+            if (field.find_first_of(" \t\r\v\f") != std::string_view::npos)
+            {
+                throw std::runtime_error("Invalid matrix element: '" + std::string(field) + "'.");
+            }
+            ++fields;
+            if (comma == current.size())
+            {
+                break;
+            }
+            pos = comma + 1;
+        }
+        if (rows == 0)
+        {
+            cols = fields;
+        }
+        else if (fields != cols)
+        {
+            throw std::runtime_error("CSV line " + std::to_string(line) + " has " + std::to_string(fields) +
+                                     " fields, expected " + std::to_string(cols) + ".");
+        }
+        ++rows;
+    }
+    if (rows == 0)
+    {
+        return Matrix<T>();
+    }
+    // Every field is now a single token, so the tokens fall in row order
+    return parseMatrix<T>(text, rows, cols, threads);
+}
+
+// Parses the Matrix Market array and coordinate formats with real or
+// integer entries and general or symmetric storage
+template <TextNumber T>
+Matrix<T> parseMatrixMarket(std::string_view text, int threads = 0)
+{
+    std::size_t lineEnd = std::min(text.find('\n'), text.size());
+    std::istringstream banner{std::string(text.substr(0, lineEnd))};
+    std::string tag, object, layout, field, symmetry;
+    banner >> tag >> object >> layout >> field >> symmetry;
+    auto lower = [](std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return s;
+    };
+    layout = lower(layout);
+    field = lower(field);
+    symmetry = lower(symmetry);
+    if (tag != "%%MatrixMarket" || lower(object) != "matrix" ||
+        (layout != "array" && layout != "coordinate") ||
+        (field != "real" && field != "integer" && field != "double") ||
+        (symmetry != "general" && symmetry != "symmetric"))
+    {
+        throw std::runtime_error("Unsupported Matrix Market format.");
+    }
+
+    // Skip comment lines up to the size line
+    std::size_t pos = lineEnd;
+    std::string_view sizeLine;
+    while (pos < text.size())
+    {
+        std::size_t start = pos + 1;
+        std::size_t end = std::min(text.find('\n', start), text.size());
+        std::string_view line = text.substr(start, std::min(end, text.size()) - start);
+        pos = end;
+        if (!line.empty() && line[0] == '%')
+        {
+            continue;
+        }
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+        {
+            continue;
+        }
+        sizeLine = line;
+        break;
+    }
+    std::istringstream sizes{std::string(sizeLine)};
+    long long rows = -1, cols = -1, entries = -1;
+    sizes >> rows >> cols;
+    if (layout == "coordinate")
+    {
+        sizes >> entries;
+    }
+    if (rows < 0 || cols < 0 || (layout == "coordinate" && entries < 0))
+    {
+        throw std::runtime_error("Invalid Matrix Market size line.");
+    }
+    if (rows > std::numeric_limits<int>::max() || cols > std::numeric_limits<int>::max())
+    {
+        throw std::runtime_error("Matrix Market dimensions are too large.");
+    }
+    const bool symmetric = symmetry == "symmetric";
+    if (symmetric && rows != cols)
+    {
+        throw std::runtime_error("Matrix must be square.");
+    }
+    // Symmetric matrices store only the lower triangle
+    const long long stored = symmetric ? rows * (rows + 1) / 2 : rows * cols;
+    if (layout == "coordinate" && entries > stored)
+    {
+        throw std::runtime_error("Invalid Matrix Market size line.");
+    }
+    // Every token takes at least one character and a separator, so a size
+    // line the body cannot hold is rejected before anything is allocated
+    std::string_view body = pos < text.size() ? text.substr(pos) : std::string_view();
+    const long long capacity = static_cast<long long>(body.size() / 2 + 1);
+    if (layout == "array" ? stored > capacity : entries > capacity / 3)
+    {
+        throw std::runtime_error("Matrix Market data is shorter than its size line.");
+    }
+    Matrix<T> m(static_cast<int>(rows), static_cast<int>(cols));
+
+    if (layout == "array")
+    {
+        // Column-major; symmetric matrices list only the lower triangle
+        if (!symmetric)
+        {
+            parseTokens<T>(
+                body, static_cast<std::size_t>(stored), [&](std::size_t index, T value)
+                { m[index % rows][index / rows] = value; },
+                threads);
+            return m;
+        }
+        std::vector<T> lowerTriangle(static_cast<std::size_t>(stored));
+        parseTokens<T>(
+            body, lowerTriangle.size(), [&](std::size_t index, T value)
+            { lowerTriangle[index] = value; },
+            threads);
+        std::size_t index = 0;
+        for (int j = 0; j < cols; ++j)
+        {
+            for (int i = j; i < rows; ++i)
+            {
+                m[i][j] = m[j][i] = lowerTriangle[index++];
+            }
+        }
+        return m;
+    }
+
+    // Coordinate: one "row column value" triple (1-based) per entry
+    std::vector<std::string_view> tokens;
+    tokens.reserve(static_cast<std::size_t>(entries) * 3);
+    for (std::size_t i = 0; i < body.size();)
+    {
+        while (i < body.size() && isSeparator(body[i]))
+        {
+            ++i;
+        }
+        std::size_t start = i;
+        while (i < body.size() && !isSeparator(body[i]))
+        {
+            ++i;
+        }
+        if (i > start)
+        {
+            tokens.push_back(body.substr(start, i - start));
+        }
+    }
+    if (tokens.size() != static_cast<std::size_t>(entries) * 3)
+    {
+        throw std::runtime_error("Expected " + std::to_string(entries) + " Matrix Market entries.");
+    }
+    for (std::size_t e = 0; e < tokens.size(); e += 3)
+    {
+        long long i = parseNumber<long long>(tokens[e]) - 1;
+        long long j = parseNumber<long long>(tokens[e + 1]) - 1;
+        if (i < 0 || i >= rows || j < 0 || j >= cols)
+        {
+            throw std::runtime_error("Matrix Market entry out of range.");
+        }
+        T value = parseNumber<T>(tokens[e + 2]);
+        m[i][j] = value;
+        if (symmetric)
+        {
+            m[j][i] = value;
+        }
+    }
+    return m;
+}
+
+// Reads the rest of the stream into memory in one pass
+inline std::string readAll(std::istream &is)
+{
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+#endif // MATRIX_IO_H
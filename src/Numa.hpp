@@ -0,0 +1,191 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// NUMA topology, thread pinning and row placement policies.
+//
+// A Matrix stores each row in its own allocation, and Linux places a
+// page on the node of the thread that first writes it. Placement is
+// therefore controlled by which thread constructs each row:
+//
+// - FirstTouch: with pinning enabled, rows are constructed by pinned
+//   parallelFor() workers, one contiguous chunk of rows per default
+//   worker. Kernels that split all rows between the default number of
+//   workers (operator* on large matrices) then find their rows on their
+//   own node; kernels that use fewer workers get a coarser split that
+//   is only partly local. Without pinning no worker stays on a node, so
+//   rows are constructed by the caller.
+// - Interleave: row i is constructed on node i % nodes, spreading the
+//   matrix evenly over all memory controllers
+// - Caller: every row is constructed by the calling thread
+//
+// No libnuma is required: the topology is read from sysfs, and on other
+// platforms (or single-node machines) everything degrades to one node.
+
+enum class Placement
+{
+    FirstTouch,
+    Interleave,
+    Caller
+};
+
+// How parallelFor() binds worker w to a CPU
+enum class Pinning
+{
+    None,    // Let the scheduler place workers
+    Compact, // Fill the CPUs of node 0 first, then node 1, ...
+    Scatter  // Alternate nodes: worker w runs on node w % nodes
+};
+
+struct NumaTopology
+{
+    // CPUs of each node, in ascending order
+    std::vector<std::vector<int>> nodeCpus;
+
+    int nodes() const { return static_cast<int>(nodeCpus.size()); }
+};
+
+namespace numa_detail
+{
+    // Parses a sysfs list such as "0-3,8-11" (used for both CPUs and nodes)
+    inline std::vector<int> parseCpuList(const std::string &text)
+    {
+        std::vector<int> cpus;
+        std::stringstream ranges(text);
+        std::string range;
+        while (std::getline(ranges, range, ','))
+        {
+            if (range.find_first_of("0123456789") == std::string::npos)
+            {
+                continue;
+            }
+            std::size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    inline NumaTopology detectTopology()
+    {
+        NumaTopology topology;
+#ifdef __linux__
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string nodes;
+        if (online && std::getline(online, nodes))
+        {
+            for (int node : parseCpuList(nodes))
+            {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string text;
+                if (file && std::getline(file, text))
+                {
+                    std::vector<int> cpus = parseCpuList(text);
+                    if (!cpus.empty())
+                    {
+                        topology.nodeCpus.push_back(cpus);
+                    }
+                }
+            }
+        }
+#endif
+        if (topology.nodeCpus.empty())
+        {
+            unsigned n = std::thread::hardware_concurrency();
+            topology.nodeCpus.emplace_back();
+            for (unsigned cpu = 0; cpu < (n ? n : 1); ++cpu)
+            {
+                topology.nodeCpus[0].push_back(static_cast<int>(cpu));
+            }
+        }
+        return topology;
+    }
+
+    inline std::atomic<Placement> placement{Placement::FirstTouch};
+    inline std::atomic<Pinning> pinning{Pinning::None};
+}
+
+// Topology of the machine, detected once
+inline const NumaTopology &numaTopology()
+{
+    static const NumaTopology topology = numa_detail::detectTopology();
+    return topology;
+}
+
+// Row placement used by new matrices (default FirstTouch)
+inline void setPlacement(Placement placement) { numa_detail::placement = placement; }
+
+inline Placement placement() { return numa_detail::placement.load(); }
+
+// Worker pinning used by parallelFor() (default None)
+inline void setPinning(Pinning pinning) { numa_detail::pinning = pinning; }
+
+inline Pinning pinning() { return numa_detail::pinning.load(); }
+
+// Binds the calling thread to the given CPUs. Returns false if the
+// platform does not support it or the CPUs are not available.
+inline bool pinCurrentThread(const std::vector<int> &cpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+// CPU that worker w is bound to under the given policy, or -1 for none
+inline int workerCpu(int worker, Pinning policy)
+{
+    const NumaTopology &topology = numaTopology();
+    if (policy == Pinning::None)
+    {
+        return -1;
+    }
+    if (policy == Pinning::Scatter)
+    {
+        const std::vector<int> &cpus = topology.nodeCpus[worker % topology.nodes()];
+        return cpus[(worker / topology.nodes()) % cpus.size()];
+    }
+    int total = 0;
+    for (const std::vector<int> &cpus : topology.nodeCpus)
+    {
+        total += static_cast<int>(cpus.size());
+    }
+    int index = worker % total;
+    for (const std::vector<int> &cpus : topology.nodeCpus)
+    {
+        if (index < static_cast<int>(cpus.size()))
+        {
+            return cpus[index];
+        }
+        index -= static_cast<int>(cpus.size());
+    }
+    return -1;
+}
+
+#endif // NUMA_H
@@ -0,0 +1,177 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "Numa.hpp"
+
+namespace parallel_detail
+{
+    inline std::atomic<int> threadsOverride{0};
+}
+
+// Number of worker threads used when a caller passes threads = 0
+inline int defaultThreads()
+{
+    const int threads = parallel_detail::threadsOverride.load();
+    if (threads > 0)
+    {
+        return threads;
+    }
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? static_cast<int>(n) : 1;
+}
+
+// Overrides defaultThreads(); 0 restores one worker per hardware thread
+inline void setDefaultThreads(int threads) { parallel_detail::threadsOverride = threads; }
+
+// Number of workers parallelFor() will actually use for a range
+inline int workerCount(int begin, int end, int threads = 0, int minChunk = 1)
+{
+    if (threads <= 0)
+    {
+        threads = defaultThreads();
+    }
+    int chunks = (end - begin) / std::max(minChunk, 1);
+    return std::max(1, std::min(threads, chunks));
+}
+
+// Splits [begin, end) into one contiguous chunk per worker and calls
+// fn(chunkBegin, chunkEnd, worker) on each. The calling thread runs the
+// first chunk itself unless workers are pinned (see setPinning()), in
+// which case every chunk runs on a thread bound to workerCpu(worker).
+// Exceptions thrown by a worker are rethrown here.
+template <typename F>
+void parallelFor(int begin, int end, F &&fn, int threads = 0, int minChunk = 1)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+    int workers = workerCount(begin, end, threads, minChunk);
+    if (workers == 1)
+    {
+        fn(begin, end, 0);
+        return;
+    }
+
+    int length = end - begin;
+    auto chunkStart = [&](int w)
+    { return begin + static_cast<int>(static_cast<long long>(length) * w / workers); };
+
+    const Pinning policy = pinning();
+    const int first = policy == Pinning::None ? 1 : 0;
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(workers);
+    pool.reserve(workers - first);
+    for (int w = first; w < workers; ++w)
+    {
+        pool.emplace_back([&, w]
+                          {
+            try
+            {
+                int cpu = workerCpu(w, policy);
+                if (cpu >= 0)
+                {
+                    pinCurrentThread({cpu});
+                }
+                fn(chunkStart(w), chunkStart(w + 1), w);
+            }
+            catch (...)
+            {
+                errors[w] = std::current_exception();
+            } });
+    }
+    if (first == 1)
+    {
+        try
+        {
+            fn(chunkStart(0), chunkStart(1), 0);
+        }
+        catch (...)
+        {
+            errors[0] = std::current_exception();
+        }
+    }
+    for (std::thread &t : pool)
+    {
+        t.join();
+    }
+    for (std::exception_ptr &e : errors)
+    {
+        if (e)
+        {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+// Element count below which matrices are always allocated by the caller
+constexpr long long minElementsForPlacedAllocation = 1 << 18;
+
+// Constructs rows.size() zero-initialized rows of `cols` elements
+// according to the current placement() policy (see Numa.hpp). Small
+// matrices, and FirstTouch matrices while workers are unpinned, are
+// allocated by the caller without starting any threads.
+template <typename T>
+void allocateRows(std::vector<std::vector<T>> &rows, int cols)
+{
+    const int n = static_cast<int>(rows.size());
+    const Placement policy = placement();
+    if (policy == Placement::Caller || (policy == Placement::FirstTouch && pinning() == Pinning::None) ||
+        static_cast<long long>(n) * cols < minElementsForPlacedAllocation)
+    {
+        for (std::vector<T> &row : rows)
+        {
+            row.assign(cols, T());
+        }
+        return;
+    }
+    if (policy == Placement::FirstTouch)
+    {
+        parallelFor(0, n, [&](int begin, int end, int)
+                    {
+                        for (int i = begin; i < end; ++i)
+                        {
+                            rows[i].assign(cols, T());
+                        } });
+        return;
+    }
+    // Interleave: one thread per node, bound to that node's CPUs
+    const NumaTopology &topology = numaTopology();
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(topology.nodes());
+    for (int node = 0; node < topology.nodes(); ++node)
+    {
+        pool.emplace_back([&, node]
+                          {
+            try
+            {
+                pinCurrentThread(topology.nodeCpus[node]);
+                for (int i = node; i < n; i += topology.nodes())
+                {
+                    rows[i].assign(cols, T());
+                }
+            }
+            catch (...)
+            {
+                errors[node] = std::current_exception();
+            } });
+    }
+    for (std::thread &t : pool)
+    {
+        t.join();
+    }
+    for (std::exception_ptr &e : errors)
+    {
+        if (e)
+        {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+#endif // PARALLEL_H
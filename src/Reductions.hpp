@@ -0,0 +1,436 @@
+#ifndef REDUCTIONS_H
+#define REDUCTIONS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+
+// Whole-matrix, row-wise and column-wise reductions and matrix norms.
+//
+// Rows are stored contiguously, so every kernel walks rows: row
+// reductions use pairwise summation over the row, and column reductions
+// add whole rows into a vector of column accumulators (with Kahan
+// compensation for floating point) instead of striding down columns.
+// Rows are split between worker threads; `threads` = 0 uses one worker
+// per hardware thread, and small matrices always run on the caller.
+
+// Floating point type that norms of a Matrix<T> are returned in
+template <typename T>
+using NormType = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+namespace reductions_detail
+{
+    // Rows handed to each worker are sized so that a worker touches at
+    // least this many elements; below that threading costs more than it saves
+    constexpr int minElementsPerWorker = 1 << 15;
+
+    // Number of independent accumulators in the inner loops. Separate
+    // accumulators break the add dependency chain so the compiler can keep
+    // them in one vector register.
+    constexpr std::size_t lanes = 8;
+
+    // Below this length a block is summed directly with `lanes` accumulators
+    constexpr std::size_t pairwiseBlock = 128;
+
+    inline int minRows(int cols)
+    {
+        return std::max(1, minElementsPerWorker / std::max(cols, 1));
+    }
+
+    // |x| in the floating point norm type R. Converting first keeps the
+    // most negative integer representable (negating it overflows T).
+    template <typename R, typename T>
+    R magnitude(T x)
+    {
+        return std::fabs(static_cast<R>(x));
+    }
+
+    // Pairwise sum of f(x[0]) ... f(x[n - 1]) accumulated in Acc. The error
+    // grows as O(log n) rather than O(n) for recursive summation.
+    template <typename Acc, typename T, typename F>
+    Acc pairwiseSum(const T *x, std::size_t n, F f)
+    {
+        if (n <= pairwiseBlock)
+        {
+            Acc acc[lanes] = {};
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                for (std::size_t k = 0; k < lanes; ++k)
+                {
+                    acc[k] += static_cast<Acc>(f(x[i + k]));
+                }
+            }
+            for (std::size_t k = 0; i < n; ++i, ++k)
+            {
+                acc[k] += static_cast<Acc>(f(x[i]));
+            }
+            return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        }
+        std::size_t half = (n / 2) / lanes * lanes;
+        return pairwiseSum<Acc>(x, half, f) + pairwiseSum<Acc>(x + half, n - half, f);
+    }
+
+    // Kahan-compensated column accumulators: sum[j] + comp[j] is the
+    // running total of column j. Integral types are summed exactly and do
+    // not use the compensation term.
+    template <typename Acc>
+    struct ColumnAccumulator
+    {
+        std::vector<Acc> sum, comp;
+
+        explicit ColumnAccumulator(int cols) : sum(cols), comp(cols) {}
+
+        template <typename T, typename F>
+        void addRow(const T *x, F f)
+        {
+            const int n = static_cast<int>(sum.size());
+            Acc *s = sum.data();
+            Acc *c = comp.data();
+            if constexpr (std::is_floating_point_v<Acc>)
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    Acc y = static_cast<Acc>(f(x[j])) - c[j];
+                    Acc t = s[j] + y;
+                    c[j] = (t - s[j]) - y;
+                    s[j] = t;
+                }
+            }
+            else
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    s[j] += static_cast<Acc>(f(x[j]));
+                }
+            }
+        }
+
+        void merge(const ColumnAccumulator &other)
+        {
+            addRow(other.sum.data(), [](Acc v)
+                   { return v; });
+            if constexpr (std::is_floating_point_v<Acc>)
+            {
+                addRow(other.comp.data(), [](Acc v)
+                       { return -v; });
+            }
+        }
+
+        std::vector<Acc> result() const
+        {
+            std::vector<Acc> out(sum.size());
+            for (std::size_t j = 0; j < sum.size(); ++j)
+            {
+                out[j] = sum[j] - comp[j];
+            }
+            return out;
+        }
+    };
+
+    // Column-wise reduction of f over all rows, one accumulator per worker
+    template <typename Acc, typename T, typename F>
+    std::vector<Acc> columnSums(const Matrix<T> &m, F f, int threads)
+    {
+        const int rows = m.rows(), cols = m.cols();
+        const int workers = workerCount(0, rows, threads, minRows(cols));
+        std::vector<ColumnAccumulator<Acc>> partial(workers, ColumnAccumulator<Acc>(cols));
+        parallelFor(
+            0, rows, [&](int begin, int end, int w)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    partial[w].addRow(m[i].data(), f);
+                } },
+            workers, minRows(cols));
+        for (int w = 1; w < workers; ++w)
+        {
+            partial[0].merge(partial[w]);
+        }
+        return partial[0].result();
+    }
+
+    // Row-wise reduction rowOp(row pointer, cols) -> R for every row
+    template <typename R, typename T, typename RowOp>
+    std::vector<R> mapRows(const Matrix<T> &m, RowOp rowOp, int threads)
+    {
+        const int cols = m.cols();
+        std::vector<R> out(m.rows());
+        parallelFor(
+            0, m.rows(), [&](int begin, int end, int)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    out[i] = rowOp(m[i].data(), cols);
+                } },
+            threads, minRows(cols));
+        return out;
+    }
+
+    template <typename T>
+    void requireNonEmpty(const Matrix<T> &m)
+    {
+        if (m.rows() == 0 || m.cols() == 0)
+        {
+            throw std::runtime_error("Matrix must not be empty.");
+        }
+    }
+
+    // Column-wise min or max: each worker folds its rows into a copy of
+    // its first row with pick(current, candidate), then the copies are folded
+    template <typename T, typename Pick>
+    std::vector<T> columnExtrema(const Matrix<T> &m, Pick pick, int threads)
+    {
+        requireNonEmpty(m);
+        const int cols = m.cols();
+        const int workers = workerCount(0, m.rows(), threads, minRows(cols));
+        std::vector<std::vector<T>> partial(workers);
+        auto fold = [&](std::vector<T> &acc, const T *x)
+        {
+            T *out = acc.data();
+            for (int j = 0; j < cols; ++j)
+            {
+                out[j] = pick(out[j], x[j]);
+            }
+        };
+        parallelFor(
+            0, m.rows(), [&](int begin, int end, int w)
+            {
+                partial[w] = m[begin];
+                for (int i = begin + 1; i < end; ++i)
+                {
+                    fold(partial[w], m[i].data());
+                } },
+            workers, minRows(cols));
+        for (int w = 1; w < workers; ++w)
+        {
+            fold(partial[0], partial[w].data());
+        }
+        return partial[0];
+    }
+
+    // Sum of squares of a row as scale^2 * squares, where scale is a power
+    // of two and every scaled entry lies below 2
+    template <typename R>
+    struct ScaledSquares
+    {
+        R scale = 0;
+        R squares = 0;
+    };
+
+    template <typename R, typename T>
+    ScaledSquares<R> scaledSquares(const T *x, int n)
+    {
+        // Separate maxima per lane, as in pairwiseSum, so the loop vectorizes
+        R lane[lanes] = {};
+        int j = 0;
+        for (; j + static_cast<int>(lanes) <= n; j += lanes)
+        {
+            for (std::size_t k = 0; k < lanes; ++k)
+            {
+                R v = magnitude<R>(x[j + k]);
+                lane[k] = lane[k] < v ? v : lane[k];
+            }
+        }
+        for (std::size_t k = 0; j < n; ++j, ++k)
+        {
+            R v = magnitude<R>(x[j]);
+            lane[k] = lane[k] < v ? v : lane[k];
+        }
+        R largest = 0;
+        for (R v : lane)
+        {
+            largest = std::max(largest, v);
+        }
+        if (largest == 0)
+        {
+            // Zero apart from any NaNs, which the lane maxima skip
+            return {0, pairwiseSum<R>(x, static_cast<std::size_t>(n), [](T v)
+                                      { return static_cast<R>(v) * static_cast<R>(v); })};
+        }
+        // NaNs propagate through the sum below; infinities are left unscaled
+        int exponent = 1;
+        if (std::isfinite(largest))
+        {
+            std::frexp(largest, &exponent);
+        }
+        exponent = std::max(exponent - 1, std::numeric_limits<R>::min_exponent - 1);
+        const R factor = std::ldexp(R(1), -exponent);
+        return {std::ldexp(R(1), exponent), pairwiseSum<R>(x, static_cast<std::size_t>(n), [factor](T v)
+                                                           {
+            R t = static_cast<R>(v) * factor;
+            return t * t; })};
+    }
+
+    template <typename T>
+    T rowMin(const T *x, int n)
+    {
+        T best = x[0];
+        for (int j = 1; j < n; ++j)
+        {
+            best = x[j] < best ? x[j] : best;
+        }
+        return best;
+    }
+
+    template <typename T>
+    T rowMax(const T *x, int n)
+    {
+        T best = x[0];
+        for (int j = 1; j < n; ++j)
+        {
+            best = best < x[j] ? x[j] : best;
+        }
+        return best;
+    }
+}
+
+// Row-wise reductions
+template <typename T>
+std::vector<T> rowSums(const Matrix<T> &m, int threads = 0)
+{
+    return reductions_detail::mapRows<T>(
+        m, [](const T *x, int n)
+        { return reductions_detail::pairwiseSum<T>(x, n, [](T v)
+                                                   { return v; }); },
+        threads);
+}
+
+template <typename T>
+std::vector<T> rowMins(const Matrix<T> &m, int threads = 0)
+{
+    reductions_detail::requireNonEmpty(m);
+    return reductions_detail::mapRows<T>(m, reductions_detail::rowMin<T>, threads);
+}
+
+template <typename T>
+std::vector<T> rowMaxs(const Matrix<T> &m, int threads = 0)
+{
+    reductions_detail::requireNonEmpty(m);
+    return reductions_detail::mapRows<T>(m, reductions_detail::rowMax<T>, threads);
+}
+
+// Column-wise reductions
+template <typename T>
+std::vector<T> colSums(const Matrix<T> &m, int threads = 0)
+{
+    return reductions_detail::columnSums<T>(m, [](T v)
+                                            { return v; }, threads);
+}
+
+template <typename T>
+std::vector<T> colMins(const Matrix<T> &m, int threads = 0)
+{
+    return reductions_detail::columnExtrema(m, [](T a, T b)
+                                            { return b < a ? b : a; }, threads);
+}
+
+template <typename T>
+std::vector<T> colMaxs(const Matrix<T> &m, int threads = 0)
+{
+    return reductions_detail::columnExtrema(m, [](T a, T b)
+                                            { return a < b ? b : a; }, threads);
+}
+
+// Whole-matrix reductions
+template <typename T>
+T sum(const Matrix<T> &m, int threads = 0)
+{
+    std::vector<T> rows = rowSums(m, threads);
+    return reductions_detail::pairwiseSum<T>(rows.data(), rows.size(), [](T v)
+                                             { return v; });
+}
+
+template <typename T>
+T minElement(const Matrix<T> &m, int threads = 0)
+{
+    std::vector<T> rows = rowMins(m, threads);
+    return reductions_detail::rowMin(rows.data(), static_cast<int>(rows.size()));
+}
+
+template <typename T>
+T maxElement(const Matrix<T> &m, int threads = 0)
+{
+    std::vector<T> rows = rowMaxs(m, threads);
+    return reductions_detail::rowMax(rows.data(), static_cast<int>(rows.size()));
+}
+
+template <typename T>
+T trace(const Matrix<T> &m)
+{
+    if (m.rows() != m.cols())
+    {
+        throw std::runtime_error("Matrix must be square.");
+    }
+    reductions_detail::ColumnAccumulator<T> acc(1);
+    for (int i = 0; i < m.rows(); ++i)
+    {
+        acc.addRow(&m[i][i], [](T v)
+                   { return v; });
+    }
+    return acc.result()[0];
+}
+
+// Norms
+
+// Frobenius norm with a scaled sum of squares (as in LAPACK's dlassq), so
+// entries whose squares overflow or underflow still give the right
+// result. Each row is scaled by a power of two near its largest entry,
+// which is exact, and the per-row sums are rescaled to the largest scale.
+template <typename T>
+NormType<T> frobeniusNorm(const Matrix<T> &m, int threads = 0)
+{
+    using R = NormType<T>;
+    std::vector<reductions_detail::ScaledSquares<R>> rows = reductions_detail::mapRows<reductions_detail::ScaledSquares<R>>(
+        m, reductions_detail::scaledSquares<R, T>, threads);
+    R scale = 0;
+    for (const reductions_detail::ScaledSquares<R> &row : rows)
+    {
+        scale = std::max(scale, row.scale);
+    }
+    if (scale == 0)
+    {
+        // Every row is zero, or zero apart from NaNs
+        return std::sqrt(reductions_detail::pairwiseSum<R>(rows.data(), rows.size(), [](const reductions_detail::ScaledSquares<R> &row)
+                                                           { return row.squares; }));
+    }
+    R squares = reductions_detail::pairwiseSum<R>(rows.data(), rows.size(), [scale](const reductions_detail::ScaledSquares<R> &row)
+                                                  {
+        R ratio = row.scale / scale;
+        return row.squares * ratio * ratio; });
+    return scale * std::sqrt(squares);
+}
+
+// Maximum absolute column sum
+template <typename T>
+NormType<T> norm1(const Matrix<T> &m, int threads = 0)
+{
+    using R = NormType<T>;
+    reductions_detail::requireNonEmpty(m);
+    std::vector<R> cols = reductions_detail::columnSums<R>(m, [](T v)
+                                                           { return reductions_detail::magnitude<R>(v); },
+                                                           threads);
+    return *std::max_element(cols.begin(), cols.end());
+}
+
+// Maximum absolute row sum
+template <typename T>
+NormType<T> normInf(const Matrix<T> &m, int threads = 0)
+{
+    using R = NormType<T>;
+    reductions_detail::requireNonEmpty(m);
+    std::vector<R> rows = reductions_detail::mapRows<R>(
+        m, [](const T *x, int n)
+        { return reductions_detail::pairwiseSum<R>(x, n, [](T v)
+                                                   { return reductions_detail::magnitude<R>(v); }); },
+        threads);
+    return *std::max_element(rows.begin(), rows.end());
+}
+
+#endif // REDUCTIONS_H
@@ -0,0 +1,1209 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+#include "Householder.hpp"
+
+// Eigenvalues, eigenvectors and singular values of Matrix<double>.
+//
+// - symmetricEigen(): blocked Householder reduction to tridiagonal form
+//   followed by Cuppen's divide-and-conquer tridiagonal eigensolver
+// - eigenvalues(): Householder reduction to Hessenberg form followed by
+//   the Francis double-shift QR iteration
+// - svd(): one-sided (Hestenes) Jacobi
+//
+// Internally vectors are kept as rows so that every update walks
+// contiguous memory. `threads` = 0 uses one worker per hardware thread.
+
+// A = vectors * diag(values) * vectors^T with values in ascending order
+// and the eigenvectors stored in the columns of `vectors`
+struct SymmetricEigen
+{
+    std::vector<double> values;
+    Matrix<double> vectors;
+};
+
+// A = U * diag(S) * V^T (thin SVD) with S in descending order. For an
+// m x n matrix and r = min(m, n), U is m x r and V is n x r, both with
+// orthonormal columns even when some singular values are zero.
+struct SVD
+{
+    Matrix<double> U;
+    std::vector<double> S;
+    Matrix<double> V;
+};
+
+namespace spectral_detail
+{
+    using Rows = std::vector<std::vector<double>>;
+
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+
+    // Subproblems at or below this size are solved with implicit QL
+    constexpr int divideAndConquerCutoff = 32;
+
+    // Minimum rows per worker for the O(n^2)-per-step updates
+    constexpr int minRowsPerWorker = 16;
+
+    // Default panel width of the blocked tridiagonal reduction
+    constexpr int tridiagonalBlock = 32;
+
+    inline void notConverged()
+    {
+        throw std::runtime_error("Eigenvalue iteration did not converge.");
+    }
+
+    inline Rows identityRows(int n)
+    {
+        Rows rows(n, std::vector<double>(n));
+        for (int i = 0; i < n; ++i)
+        {
+            rows[i][i] = 1;
+        }
+        return rows;
+    }
+
+    // Sorts values ascending and permutes rows to match
+    inline void sortAscending(std::vector<double> &values, Rows &rows)
+    {
+        std::vector<int> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b)
+                  { return values[a] < values[b]; });
+        std::vector<double> sortedValues(values.size());
+        Rows sortedRows(rows.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            sortedValues[i] = values[order[i]];
+            sortedRows[i] = std::move(rows[order[i]]);
+        }
+        values = std::move(sortedValues);
+        rows = std::move(sortedRows);
+    }
+
+    // Implicit QL with Wilkinson shifts on the symmetric tridiagonal matrix
+    // with diagonal d and off-diagonal e (e[i] couples i and i + 1, e[n-1]
+    // is ignored). On return d holds the eigenvalues in ascending order and
+    // vecs[i] the eigenvector for d[i].
+    inline void tridiagonalQL(std::vector<double> &d, std::vector<double> e, Rows &vecs)
+    {
+        const int n = static_cast<int>(d.size());
+        vecs = identityRows(n);
+        if (n == 0)
+        {
+            return;
+        }
+        e[n - 1] = 0;
+        double shift = 0, norm = 0;
+        for (int l = 0; l < n; ++l)
+        {
+            norm = std::max(norm, std::fabs(d[l]) + std::fabs(e[l]));
+            int m = l;
+            while (m < n - 1 && std::fabs(e[m]) > eps * norm)
+            {
+                ++m;
+            }
+            int iterations = 0;
+            while (m > l)
+            {
+                if (++iterations > 60)
+                {
+                    notConverged();
+                }
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2 * e[l]);
+                double r = std::copysign(std::hypot(p, 1.0), p);
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int i = l + 2; i < n; ++i)
+                {
+                    d[i] -= h;
+                }
+                shift += h;
+
+                p = d[m];
+                double c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+                double el1 = e[l + 1];
+                for (int i = m - 1; i >= l; --i)
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+
+                    double *vi = vecs[i].data();
+                    double *vi1 = vecs[i + 1].data();
+                    for (int k = 0; k < n; ++k)
+                    {
+                        double t = vi1[k];
+                        vi1[k] = s * vi[k] + c * t;
+                        vi[k] = c * vi[k] - s * t;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+                if (std::fabs(e[l]) <= eps * norm)
+                {
+                    break;
+                }
+            }
+            d[l] += shift;
+            e[l] = 0;
+        }
+        sortAscending(d, vecs);
+    }
+
+    // Roots of the secular equation 1 + rho * sum(z_i^2 / (d_i - x)) = 0 for
+    // strictly increasing d and rho > 0. Root j lies in (d_j, d_{j+1}) (the
+    // last one in (d_{k-1}, d_{k-1} + rho * |z|^2)) and is returned as
+    // d[origin[j]] + tau[j], measured from the nearer pole so that the
+    // differences d_i - lambda_j can be formed without cancellation.
+    inline void secularRoots(const std::vector<double> &d, const std::vector<double> &z, double rho,
+                             std::vector<int> &origin, std::vector<double> &tau, int threads)
+    {
+        const int k = static_cast<int>(d.size());
+        origin.assign(k, 0);
+        tau.assign(k, 0);
+        double zz = 0;
+        for (double zi : z)
+        {
+            zz += zi * zi;
+        }
+
+        parallelFor(
+            0, k, [&](int begin, int end, int)
+            {
+                for (int j = begin; j < end; ++j)
+                {
+                    // Secular function measured from pole o: returns f, f' and
+                    // the magnitude of the terms for the stopping test
+                    auto secular = [&](int o, double t, double &df, double &scale)
+                    {
+                        double f = 1;
+                        df = 0;
+                        scale = 1;
+                        for (int i = 0; i < k; ++i)
+                        {
+                            double delta = (d[i] - d[o]) - t;
+                            double term = z[i] / delta;
+                            f += rho * z[i] * term;
+                            df += rho * term * term;
+                            scale += rho * std::fabs(z[i] * term);
+                        }
+                        return f;
+                    };
+
+                    int o = j;
+                    double lo, hi, df, scale;
+                    if (j < k - 1)
+                    {
+                        double half = (d[j + 1] - d[j]) / 2;
+                        if (secular(j, half, df, scale) >= 0)
+                        {
+                            lo = 0;
+                            hi = half;
+                        }
+                        else
+                        {
+                            o = j + 1;
+                            lo = -half;
+                            hi = 0;
+                        }
+                    }
+                    else
+                    {
+                        lo = 0;
+                        hi = rho * zz;
+                    }
+
+                    // Newton's method safeguarded by bisection on [lo, hi]
+                    double t = (lo + hi) / 2;
+                    for (int iteration = 0; iteration < 200; ++iteration)
+                    {
+                        double f = secular(o, t, df, scale);
+                        if (std::fabs(f) <= 4 * eps * k * scale)
+                        {
+                            break;
+                        }
+                        (f < 0 ? lo : hi) = t;
+                        if (hi - lo <= 2 * eps * std::max(std::fabs(lo), std::fabs(hi)))
+                        {
+                            break;
+                        }
+                        double next = t - f / df;
+                        t = next > lo && next < hi ? next : (lo + hi) / 2;
+                    }
+                    origin[j] = o;
+                    tau[j] = t;
+                } },
+            threads, 8);
+    }
+
+    // Divide and conquer for the symmetric tridiagonal matrix (d, e). On
+    // return d holds the eigenvalues in ascending order and vecs[i] the
+    // eigenvector for d[i].
+    inline void tridiagonalEigen(std::vector<double> &d, const std::vector<double> &e, Rows &vecs, int threads)
+    {
+        const int n = static_cast<int>(d.size());
+        if (n <= divideAndConquerCutoff)
+        {
+            tridiagonalQL(d, e, vecs);
+            return;
+        }
+
+        // T = diag(T1, T2) + rho * u * u^T with u = e_{m-1} + sign * e_m
+        const int m = n / 2;
+        const double beta = e[m - 1];
+        const double sign = beta < 0 ? -1 : 1;
+        double rho = std::fabs(beta);
+
+        std::vector<double> d1(d.begin(), d.begin() + m), e1(e.begin(), e.begin() + m);
+        std::vector<double> d2(d.begin() + m, d.end()), e2(e.begin() + m, e.end());
+        d1[m - 1] -= rho;
+        d2[0] -= rho;
+        e1[m - 1] = 0;
+        Rows q1, q2;
+        tridiagonalEigen(d1, e1, q1, threads);
+        tridiagonalEigen(d2, e2, q2, threads);
+
+        // Eigenvectors of diag(T1, T2) as full-length rows; [lo, hi) is the
+        // nonzero column range of each row
+        Rows q(n);
+        std::vector<int> lo(n), hi(n);
+        std::vector<double> values(n), z(n);
+        for (int i = 0; i < n; ++i)
+        {
+            q[i].assign(n, 0);
+            if (i < m)
+            {
+                std::copy(q1[i].begin(), q1[i].end(), q[i].begin());
+                values[i] = d1[i];
+                z[i] = q1[i][m - 1];
+                lo[i] = 0;
+                hi[i] = m;
+            }
+            else
+            {
+                std::copy(q2[i - m].begin(), q2[i - m].end(), q[i].begin() + m);
+                values[i] = d2[i - m];
+                z[i] = sign * q2[i - m][0];
+                lo[i] = m;
+                hi[i] = n;
+            }
+        }
+        q1.clear();
+        q2.clear();
+
+        // The problem is now diag(values) + rho * z * z^T in the basis q
+        double zNorm2 = 0, largest = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            zNorm2 += z[i] * z[i];
+            largest = std::max(largest, std::fabs(values[i]));
+        }
+        rho *= zNorm2;
+        for (double &zi : z)
+        {
+            zi /= std::sqrt(zNorm2);
+        }
+        const double tol = 8 * eps * std::max(largest, rho);
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b)
+                  { return values[a] < values[b]; });
+
+        // Deflation: drop components with negligible z, and rotate pairs of
+        // nearly equal values so that one of them has a zero z component
+        std::vector<int> kept, deflated;
+        int previous = -1;
+        for (int i : order)
+        {
+            if (rho * std::fabs(z[i]) <= tol)
+            {
+                deflated.push_back(i);
+                continue;
+            }
+            if (previous >= 0)
+            {
+                int p = previous;
+                double r = std::hypot(z[p], z[i]);
+                double c = z[i] / r, s = -z[p] / r;
+                if (std::fabs((values[i] - values[p]) * c * s) <= tol)
+                {
+                    z[p] = 0;
+                    z[i] = r;
+                    double dp = values[p], di = values[i];
+                    values[p] = c * c * dp + s * s * di;
+                    values[i] = s * s * dp + c * c * di;
+                    double *qp = q[p].data();
+                    double *qi = q[i].data();
+                    int from = std::min(lo[p], lo[i]), to = std::max(hi[p], hi[i]);
+                    for (int col = from; col < to; ++col)
+                    {
+                        double a = qp[col], b = qi[col];
+                        qp[col] = c * a + s * b;
+                        qi[col] = -s * a + c * b;
+                    }
+                    lo[p] = lo[i] = from;
+                    hi[p] = hi[i] = to;
+                    deflated.push_back(p);
+                    previous = i;
+                    continue;
+                }
+                kept.push_back(p);
+            }
+            previous = i;
+        }
+        if (previous >= 0)
+        {
+            kept.push_back(previous);
+        }
+
+        const int k = static_cast<int>(kept.size());
+        std::vector<double> dk(k), zk(k);
+        for (int i = 0; i < k; ++i)
+        {
+            dk[i] = values[kept[i]];
+            zk[i] = z[kept[i]];
+        }
+        std::vector<int> origin;
+        std::vector<double> tau;
+        secularRoots(dk, zk, rho, origin, tau, threads);
+
+        // delta[j][i] = dk[i] - lambda_j, formed relative to the nearer pole
+        Rows delta(k, std::vector<double>(k));
+        parallelFor(
+            0, k, [&](int begin, int end, int)
+            {
+                for (int j = begin; j < end; ++j)
+                {
+                    for (int i = 0; i < k; ++i)
+                    {
+                        delta[j][i] = (dk[i] - dk[origin[j]]) - tau[j];
+                    }
+                } },
+            threads, minRowsPerWorker);
+
+        // Recompute z from the computed roots (Gu and Eisenstat) so that the
+        // eigenvectors are numerically orthogonal
+        std::vector<double> zHat(k);
+        for (int i = 0; i < k; ++i)
+        {
+            double product = -delta[i][i] / rho;
+            for (int j = 0; j < k; ++j)
+            {
+                if (j != i)
+                {
+                    product *= delta[j][i] / (dk[i] - dk[j]);
+                }
+            }
+            zHat[i] = std::copysign(std::sqrt(std::fabs(product)), zk[i]);
+        }
+
+        // Eigenvectors: row j = sum_i (zHat_i / delta[j][i]) * q[kept[i]]
+        Rows result(n);
+        std::vector<double> resultValues(n);
+        parallelFor(
+            0, k, [&](int begin, int end, int)
+            {
+                std::vector<double> coeff(k);
+                for (int j = begin; j < end; ++j)
+                {
+                    double norm2 = 0;
+                    for (int i = 0; i < k; ++i)
+                    {
+                        coeff[i] = zHat[i] / delta[j][i];
+                        norm2 += coeff[i] * coeff[i];
+                    }
+                    double inv = 1 / std::sqrt(norm2);
+                    std::vector<double> row(n);
+                    double *out = row.data();
+                    for (int i = 0; i < k; ++i)
+                    {
+                        const double *src = q[kept[i]].data();
+                        double c = coeff[i] * inv;
+                        for (int col = lo[kept[i]]; col < hi[kept[i]]; ++col)
+                        {
+                            out[col] += c * src[col];
+                        }
+                    }
+                    result[j] = std::move(row);
+                    resultValues[j] = dk[origin[j]] + tau[j];
+                } },
+            threads, 1);
+        for (std::size_t i = 0; i < deflated.size(); ++i)
+        {
+            result[k + i] = std::move(q[deflated[i]]);
+            resultValues[k + i] = values[deflated[i]];
+        }
+
+        sortAscending(resultValues, result);
+        d = std::move(resultValues);
+        vecs = std::move(result);
+    }
+
+    // Splits rows [begin, n) whose work is proportional to n - i (the
+    // upper triangle of an n x n matrix) into `parts` ranges of equal work
+    inline std::vector<int> triangleCuts(int begin, int n, int parts)
+    {
+        std::vector<int> cut(parts + 1, n);
+        cut[0] = begin;
+        const double total = 0.5 * (n - begin) * (n - begin + 1.0);
+        double done = 0;
+        int part = 1;
+        for (int i = begin; i < n && part < parts; ++i)
+        {
+            done += n - i;
+            while (part < parts && done >= total * part / parts)
+            {
+                cut[part++] = i + 1;
+            }
+        }
+        return cut;
+    }
+
+    // Reduces the symmetric matrix held in the upper triangle of a (row i,
+    // columns i .. n - 1; the rest is neither read nor kept up to date) to
+    // tridiagonal form Q^T * a * Q. The reflectors H_0 .. H_{n-3} with
+    // Q = H_0 * ... * H_{n-3} are returned; H_k acts on indices k + 1 .. n - 1.
+    //
+    // Blocked as in LAPACK's dsytrd / dlatrd: within a panel of nb columns
+    // the trailing matrix is not updated; each step instead corrects its
+    // row and its matrix-vector product with the panel's earlier vectors,
+    // A = A0 - V * W^T - W * V^T. The trailing matrix then receives one
+    // rank-2nb update per panel, which reads each row once per four
+    // reflectors instead of once per reflector. Keeping only the upper
+    // triangle halves both the matrix-vector traffic and the update.
+    inline std::vector<Householder> tridiagonalize(Rows &a, std::vector<double> &d, std::vector<double> &e, int threads,
+                                                   int blockSize = tridiagonalBlock)
+    {
+        const int n = static_cast<int>(a.size());
+        const int nb = std::max(blockSize, 1);
+        // Resolve the default once: `partial` below is sized for it, and it
+        // may be changed by another thread during the reduction
+        if (threads <= 0)
+        {
+            threads = defaultThreads();
+        }
+        d.assign(n, 0);
+        e.assign(n, 0);
+        std::vector<Householder> reflectors;
+        // Panel vectors stored as full-length rows, zero before their offset
+        Rows v(nb, std::vector<double>(n)), w(nb, std::vector<double>(n));
+        std::vector<double> y(n);
+        // Per-worker partial products for the transposed half of the triangle
+        Rows partial(workerCount(0, n, threads, minRowsPerWorker), std::vector<double>(n));
+        for (int k0 = 0; k0 + 2 < n; k0 += nb)
+        {
+            const int k1 = std::min(k0 + nb, n - 2);
+            for (int j = k0; j < k1; ++j)
+            {
+                const int p = j - k0, off = j + 1, len = n - off;
+                // Bring row j (= column j) up to date with the panel so far
+                double *row = a[j].data();
+                for (int q = 0; q < p; ++q)
+                {
+                    const double vj = v[q][j], wj = w[q][j];
+                    const double *vq = v[q].data(), *wq = w[q].data();
+                    for (int c = j; c < n; ++c)
+                    {
+                        row[c] -= vj * wq[c] + wj * vq[c];
+                    }
+                }
+                Householder h = makeHouseholder(row + off, len);
+                d[j] = row[j];
+                e[j] = h.beta;
+                std::fill(v[p].begin(), v[p].end(), 0.0);
+                std::fill(w[p].begin(), w[p].end(), 0.0);
+                if (h.tau != 0)
+                {
+                    std::copy(h.v.begin(), h.v.end(), v[p].begin() + off);
+                    const double *vp = v[p].data();
+                    // y = A0_22 * v from the stale upper triangle: row i
+                    // contributes its dot product to y[i] and, as column i,
+                    // v[i] * row to the entries after i
+                    const int workers = workerCount(off, n, threads, minRowsPerWorker);
+                    const std::vector<int> cut = triangleCuts(off, n, workers);
+                    parallelFor(
+                        0, workers, [&](int begin, int end, int)
+                        {
+                            for (int t = begin; t < end; ++t)
+                            {
+                                double *yt = partial[t].data();
+                                std::fill(yt + off, yt + n, 0.0);
+                                for (int i = cut[t]; i < cut[t + 1]; ++i)
+                                {
+                                    const double *ai = a[i].data();
+                                    const double vi = vp[i];
+                                    double s = ai[i] * vi;
+                                    for (int c = i + 1; c < n; ++c)
+                                    {
+                                        s += ai[c] * vp[c];
+                                        yt[c] += ai[c] * vi;
+                                    }
+                                    yt[i] += s;
+                                }
+                            } },
+                        workers, 1);
+                    std::copy(partial[0].begin() + off, partial[0].end(), y.begin() + off);
+                    for (int t = 1; t < workers; ++t)
+                    {
+                        for (int c = off; c < n; ++c)
+                        {
+                            y[c] += partial[t][c];
+                        }
+                    }
+                    // y -= V * (W^T v) + W * (V^T v)
+                    for (int q = 0; q < p; ++q)
+                    {
+                        const double *vq = v[q].data(), *wq = w[q].data();
+                        double wv = 0, vv = 0;
+                        for (int c = off; c < n; ++c)
+                        {
+                            wv += wq[c] * vp[c];
+                            vv += vq[c] * vp[c];
+                        }
+                        for (int c = off; c < n; ++c)
+                        {
+                            y[c] -= vq[c] * wv + wq[c] * vv;
+                        }
+                    }
+                    // w = tau * y - (tau / 2) * (tau * y^T v) * v
+                    double yv = 0;
+                    for (int c = off; c < n; ++c)
+                    {
+                        yv += y[c] * vp[c];
+                    }
+                    const double K = h.tau * h.tau * yv / 2;
+                    double *wp = w[p].data();
+                    for (int c = off; c < n; ++c)
+                    {
+                        wp[c] = h.tau * y[c] - K * vp[c];
+                    }
+                }
+                reflectors.push_back(std::move(h));
+            }
+
+            // Upper triangle of A22 -= V * W^T + W * V^T after the panel
+            const int kb = k1 - k0;
+            const int workers = workerCount(k1, n, threads, minRowsPerWorker);
+            const std::vector<int> cut = triangleCuts(k1, n, workers);
+            parallelFor(
+                0, workers, [&](int begin, int end, int)
+                {
+                    for (int i = cut[begin]; i < cut[end]; ++i)
+                    {
+                        double *row = a[i].data();
+                        int q = 0;
+                        for (; q + 4 <= kb; q += 4)
+                        {
+                            const double *v0 = v[q].data(), *v1 = v[q + 1].data(), *v2 = v[q + 2].data(), *v3 = v[q + 3].data();
+                            const double *w0 = w[q].data(), *w1 = w[q + 1].data(), *w2 = w[q + 2].data(), *w3 = w[q + 3].data();
+                            const double a0 = v0[i], a1 = v1[i], a2 = v2[i], a3 = v3[i];
+                            const double b0 = w0[i], b1 = w1[i], b2 = w2[i], b3 = w3[i];
+                            for (int c = i; c < n; ++c)
+                            {
+                                row[c] -= (a0 * w0[c] + b0 * v0[c]) + (a1 * w1[c] + b1 * v1[c]) +
+                                          (a2 * w2[c] + b2 * v2[c]) + (a3 * w3[c] + b3 * v3[c]);
+                            }
+                        }
+                        for (; q < kb; ++q)
+                        {
+                            const double *vq = v[q].data(), *wq = w[q].data();
+                            const double aq = vq[i], bq = wq[i];
+                            for (int c = i; c < n; ++c)
+                            {
+                                row[c] -= aq * wq[c] + bq * vq[c];
+                            }
+                        }
+                    } },
+                workers, 1);
+        }
+        if (n >= 2)
+        {
+            d[n - 2] = a[n - 2][n - 2];
+            e[n - 2] = a[n - 2][n - 1];
+        }
+        if (n >= 1)
+        {
+            d[n - 1] = a[n - 1][n - 1];
+        }
+        return reflectors;
+    }
+
+    // Replaces vectors[known ..] with unit vectors orthogonal to each other
+    // and to the orthonormal vectors[0 .. known). Candidates are the unit
+    // coordinate vectors, orthogonalized by Gram-Schmidt applied twice;
+    // one of them keeps at least the average residual (m - filled) / m,
+    // so half of that is always reached.
+    inline void completeOrthonormal(Rows &vectors, int known)
+    {
+        const int count = static_cast<int>(vectors.size());
+        const int m = count > 0 ? static_cast<int>(vectors[0].size()) : 0;
+        std::vector<double> candidate(m), best;
+        int next = 0;
+        for (int filled = known; filled < count; ++filled)
+        {
+            const double target = 0.5 * (m - filled) / m;
+            double bestNorm = -1;
+            for (int tried = 0; tried < m; ++tried, next = (next + 1) % m)
+            {
+                std::fill(candidate.begin(), candidate.end(), 0.0);
+                candidate[next] = 1;
+                for (int pass = 0; pass < 2; ++pass)
+                {
+                    for (int k = 0; k < filled; ++k)
+                    {
+                        const double *q = vectors[k].data();
+                        double dot = 0;
+                        for (int i = 0; i < m; ++i)
+                        {
+                            dot += q[i] * candidate[i];
+                        }
+                        for (int i = 0; i < m; ++i)
+                        {
+                            candidate[i] -= dot * q[i];
+                        }
+                    }
+                }
+                double norm = 0;
+                for (double x : candidate)
+                {
+                    norm += x * x;
+                }
+                if (norm > bestNorm)
+                {
+                    bestNorm = norm;
+                    best = candidate;
+                }
+                if (norm >= target)
+                {
+                    break;
+                }
+            }
+            next = (next + 1) % m;
+            const double scale = 1 / std::sqrt(bestNorm);
+            for (int i = 0; i < m; ++i)
+            {
+                vectors[filled][i] = best[i] * scale;
+            }
+        }
+    }
+
+    inline Matrix<double> columnsFromRows(const Rows &rows, int rowCount)
+    {
+        Matrix<double> out(rowCount, static_cast<int>(rows.size()));
+        for (std::size_t j = 0; j < rows.size(); ++j)
+        {
+            for (int i = 0; i < rowCount; ++i)
+            {
+                out[i][j] = rows[j][i];
+            }
+        }
+        return out;
+    }
+}
+
+// Eigen-decomposition of a symmetric matrix. Only the lower triangle of
+// `a` is read. blockSize is the panel width of the tridiagonal reduction
+// (1 gives the unblocked rank-2 reduction).
+inline SymmetricEigen symmetricEigen(const Matrix<double> &a, int threads = 0, int blockSize = spectral_detail::tridiagonalBlock)
+{
+    using namespace spectral_detail;
+    if (a.rows() != a.cols())
+    {
+        throw std::runtime_error("Matrix must be square.");
+    }
+    const int n = a.rows();
+    // The reduction works on the upper triangle, where row i holds column i
+    Rows work(n, std::vector<double>(n));
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j <= i; ++j)
+        {
+            work[j][i] = a[i][j];
+        }
+    }
+
+    std::vector<double> d, e;
+    std::vector<Householder> reflectors = tridiagonalize(work, d, e, threads, blockSize);
+    work.clear();
+
+    Rows vecs;
+    tridiagonalEigen(d, e, vecs, threads);
+
+    // Eigenvector rows of A are the rows of T's eigenvectors times Q^T,
+    // i.e. the reflectors applied from the right in reverse order
+    parallelFor(
+        0, n, [&](int begin, int end, int)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                for (int k = static_cast<int>(reflectors.size()) - 1; k >= 0; --k)
+                {
+                    applyHouseholder(reflectors[k], vecs[i].data() + k + 1);
+                }
+            } },
+        threads, minRowsPerWorker);
+
+    return {d, columnsFromRows(vecs, n)};
+}
+
+// Eigenvalues of a general square matrix, sorted by real part and then by
+// imaginary part. Complex eigenvalues appear in conjugate pairs.
+inline std::vector<std::complex<double>> eigenvalues(const Matrix<double> &matrix, int threads = 0)
+{
+    using namespace spectral_detail;
+    if (matrix.rows() != matrix.cols())
+    {
+        throw std::runtime_error("Matrix must be square.");
+    }
+    const int n = matrix.rows();
+    Rows a(n);
+    for (int i = 0; i < n; ++i)
+    {
+        a[i] = matrix[i];
+    }
+
+    // Householder reduction to upper Hessenberg form
+    std::vector<double> column(n), w(n);
+    for (int k = 0; k + 2 < n; ++k)
+    {
+        const int off = k + 1, len = n - off;
+        for (int i = off; i < n; ++i)
+        {
+            column[i - off] = a[i][k];
+        }
+        Householder h = makeHouseholder(column.data(), len);
+        if (h.tau == 0)
+        {
+            continue;
+        }
+        const double *v = h.v.data();
+        // Left: rows off.. of columns k.. -= tau * v * (v^T * A)
+        std::fill(w.begin(), w.end(), 0.0);
+        for (int i = off; i < n; ++i)
+        {
+            const double *row = a[i].data();
+            double vi = h.tau * v[i - off];
+            for (int j = k; j < n; ++j)
+            {
+                w[j] += vi * row[j];
+            }
+        }
+        parallelFor(
+            off, n, [&](int begin, int end, int)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    double *row = a[i].data();
+                    double vi = v[i - off];
+                    for (int j = k; j < n; ++j)
+                    {
+                        row[j] -= vi * w[j];
+                    }
+                } },
+            threads, minRowsPerWorker);
+        a[off][k] = h.beta;
+        for (int i = off + 1; i < n; ++i)
+        {
+            a[i][k] = 0;
+        }
+        // Right: every row applies H to its columns off..
+        parallelFor(
+            0, n, [&](int begin, int end, int)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    applyHouseholder(h, a[i].data() + off);
+                } },
+            threads, minRowsPerWorker);
+    }
+
+    // Francis double-shift QR on the Hessenberg matrix
+    std::vector<double> wr(n), wi(n);
+    double anorm = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = std::max(i - 1, 0); j < n; ++j)
+        {
+            anorm += std::fabs(a[i][j]);
+        }
+    }
+    int nn = n - 1;
+    double t = 0;
+    while (nn >= 0)
+    {
+        int its = 0, l;
+        do
+        {
+            for (l = nn; l > 0; --l)
+            {
+                double s = std::fabs(a[l - 1][l - 1]) + std::fabs(a[l][l]);
+                if (s == 0)
+                {
+                    s = anorm;
+                }
+                if (std::fabs(a[l][l - 1]) <= eps * s)
+                {
+                    a[l][l - 1] = 0;
+                    break;
+                }
+            }
+            double x = a[nn][nn];
+            if (l == nn)
+            {
+                // One real root
+                wr[nn] = x + t;
+                wi[nn--] = 0;
+            }
+            else
+            {
+                double y = a[nn - 1][nn - 1];
+                double ww = a[nn][nn - 1] * a[nn - 1][nn];
+                if (l == nn - 1)
+                {
+                    // A pair of roots from the trailing 2 x 2 block
+                    double p = 0.5 * (y - x);
+                    double q = p * p + ww;
+                    double z = std::sqrt(std::fabs(q));
+                    x += t;
+                    if (q >= 0)
+                    {
+                        z = p + std::copysign(z, p);
+                        wr[nn - 1] = wr[nn] = x + z;
+                        if (z != 0)
+                        {
+                            wr[nn] = x - ww / z;
+                        }
+                        wi[nn - 1] = wi[nn] = 0;
+                    }
+                    else
+                    {
+                        wr[nn - 1] = wr[nn] = x + p;
+                        wi[nn - 1] = -z;
+                        wi[nn] = z;
+                    }
+                    nn -= 2;
+                }
+                else
+                {
+                    if (its == 60)
+                    {
+                        notConverged();
+                    }
+                    if (its == 10 || its == 20)
+                    {
+                        // Exceptional shift
+                        t += x;
+                        for (int i = 0; i <= nn; ++i)
+                        {
+                            a[i][i] -= x;
+                        }
+                        double s = std::fabs(a[nn][nn - 1]) + std::fabs(a[nn - 1][nn - 2]);
+                        y = x = 0.75 * s;
+                        ww = -0.4375 * s * s;
+                    }
+                    ++its;
+                    int m;
+                    double p = 0, q = 0, r = 0, z;
+                    for (m = nn - 2; m >= l; --m)
+                    {
+                        z = a[m][m];
+                        r = x - z;
+                        double s = y - z;
+                        p = (r * s - ww) / a[m + 1][m] + a[m][m + 1];
+                        q = a[m + 1][m + 1] - z - r - s;
+                        r = a[m + 2][m + 1];
+                        s = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                        p /= s;
+                        q /= s;
+                        r /= s;
+                        if (m == l)
+                        {
+                            break;
+                        }
+                        double u = std::fabs(a[m][m - 1]) * (std::fabs(q) + std::fabs(r));
+                        double v = std::fabs(p) * (std::fabs(a[m - 1][m - 1]) + std::fabs(z) + std::fabs(a[m + 1][m + 1]));
+                        if (u <= eps * v)
+                        {
+                            break;
+                        }
+                    }
+                    for (int i = m + 2; i <= nn; ++i)
+                    {
+                        a[i][i - 2] = 0;
+                        if (i != m + 2)
+                        {
+                            a[i][i - 3] = 0;
+                        }
+                    }
+                    for (int k = m; k <= nn - 1; ++k)
+                    {
+                        if (k != m)
+                        {
+                            p = a[k][k - 1];
+                            q = a[k + 1][k - 1];
+                            r = 0;
+                            if (k != nn - 1)
+                            {
+                                r = a[k + 2][k - 1];
+                            }
+                            if ((x = std::fabs(p) + std::fabs(q) + std::fabs(r)) != 0)
+                            {
+                                p /= x;
+                                q /= x;
+                                r /= x;
+                            }
+                        }
+                        double s = std::copysign(std::sqrt(p * p + q * q + r * r), p);
+                        if (s != 0)
+                        {
+                            if (k == m)
+                            {
+                                if (l != m)
+                                {
+                                    a[k][k - 1] = -a[k][k - 1];
+                                }
+                            }
+                            else
+                            {
+                                a[k][k - 1] = -s * x;
+                            }
+                            p += s;
+                            x = p / s;
+                            y = q / s;
+                            z = r / s;
+                            q /= p;
+                            r /= p;
+                            for (int j = k; j <= nn; ++j)
+                            {
+                                p = a[k][j] + q * a[k + 1][j];
+                                if (k != nn - 1)
+                                {
+                                    p += r * a[k + 2][j];
+                                    a[k + 2][j] -= p * z;
+                                }
+                                a[k + 1][j] -= p * y;
+                                a[k][j] -= p * x;
+                            }
+                            int mmin = nn < k + 3 ? nn : k + 3;
+                            for (int i = l; i <= mmin; ++i)
+                            {
+                                p = x * a[i][k] + y * a[i][k + 1];
+                                if (k != nn - 1)
+                                {
+                                    p += z * a[i][k + 2];
+                                    a[i][k + 2] -= p * r;
+                                }
+                                a[i][k + 1] -= p * q;
+                                a[i][k] -= p;
+                            }
+                        }
+                    }
+                }
+            }
+        } while (l < nn - 1);
+    }
+
+    std::vector<std::complex<double>> values(n);
+    for (int i = 0; i < n; ++i)
+    {
+        values[i] = {wr[i], wi[i]};
+    }
+    std::sort(values.begin(), values.end(), [](const std::complex<double> &a, const std::complex<double> &b)
+              { return a.real() != b.real() ? a.real() < b.real() : a.imag() < b.imag(); });
+    return values;
+}
+
+// Thin singular value decomposition by one-sided Jacobi rotations. Columns
+// are orthogonalized in parallel using a round-robin ordering in which
+// every round rotates n / 2 disjoint column pairs.
+inline SVD svd(const Matrix<double> &a, int threads = 0)
+{
+    using namespace spectral_detail;
+    const int m = a.rows(), n = a.cols();
+    if (m < n)
+    {
+        // Work on the transpose so that there are at least as many rows as columns
+        SVD t = svd(a.transpose(), threads);
+        return {t.V, t.S, t.U};
+    }
+
+    // Scale by a power of two so that the largest entry is near 1; this is
+    // exact and keeps the squared column norms clear of overflow and
+    // underflow for any representable input
+    double largest = 0;
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            largest = std::max(largest, std::fabs(a[i][j]));
+        }
+    }
+    int exponent = 0;
+    if (largest > 0 && std::isfinite(largest))
+    {
+        std::frexp(largest, &exponent);
+    }
+    const double factor = std::ldexp(1.0, -exponent);
+
+    // w[j] is column j of the working matrix, v[j] column j of V
+    Rows w(n, std::vector<double>(m));
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            w[j][i] = a[i][j] * factor;
+        }
+    }
+    Rows v = identityRows(n);
+
+    // Round-robin pairing: slot 0 stays fixed and the others rotate
+    const int slots = n + (n % 2);
+    std::vector<int> ring(slots);
+    std::iota(ring.begin(), ring.end(), 0);
+    // The computed inner product carries a rounding error of about
+    // sqrt(m) * eps relative to the column norms, so a tighter test never
+    // stops rotating rank-deficient columns (dgesvj uses the same bound)
+    const double tolerance = std::sqrt(static_cast<double>(m)) * eps;
+    const double negligible = std::numeric_limits<double>::min() / eps;
+    bool converged = n < 2;
+    for (int sweep = 0; sweep < 60 && !converged; ++sweep)
+    {
+        converged = true;
+        for (int round = 0; round + 1 < slots; ++round)
+        {
+            std::vector<char> rotated(slots / 2);
+            parallelFor(
+                0, slots / 2, [&](int begin, int end, int)
+                {
+                    for (int pair = begin; pair < end; ++pair)
+                    {
+                        int p = ring[pair], q = ring[slots - 1 - pair];
+                        if (p >= n || q >= n)
+                        {
+                            continue;
+                        }
+                        double *wp = w[p].data();
+                        double *wq = w[q].data();
+                        double alpha = 0, beta = 0, gamma = 0;
+                        for (int i = 0; i < m; ++i)
+                        {
+                            alpha += wp[i] * wp[i];
+                            beta += wq[i] * wq[i];
+                            gamma += wp[i] * wq[i];
+                        }
+                        // Columns of a rank-deficient matrix shrink towards
+                        // zero; once their squared norms underflow they are
+                        // rounding noise and are left alone
+                        if (std::fabs(gamma) <= tolerance * std::sqrt(alpha * beta) || gamma == 0 ||
+                            alpha < negligible || beta < negligible)
+                        {
+                            continue;
+                        }
+                        rotated[pair] = 1;
+                        double zeta = (beta - alpha) / (2 * gamma);
+                        double t = std::copysign(1.0, zeta) / (std::fabs(zeta) + std::sqrt(1 + zeta * zeta));
+                        double c = 1 / std::sqrt(1 + t * t), s = c * t;
+                        for (int i = 0; i < m; ++i)
+                        {
+                            double x = wp[i], y = wq[i];
+                            wp[i] = c * x - s * y;
+                            wq[i] = s * x + c * y;
+                        }
+                        double *vp = v[p].data();
+                        double *vq = v[q].data();
+                        for (int i = 0; i < n; ++i)
+                        {
+                            double x = vp[i], y = vq[i];
+                            vp[i] = c * x - s * y;
+                            vq[i] = s * x + c * y;
+                        }
+                    } },
+                threads, std::max(1, 256 / std::max(m, 1)));
+            for (char r : rotated)
+            {
+                converged = converged && !r;
+            }
+            std::rotate(ring.begin() + 1, ring.end() - 1, ring.end());
+        }
+    }
+    if (!converged)
+    {
+        notConverged();
+    }
+
+    // Singular values are the column norms; U holds the normalized columns
+    std::vector<double> sigma(n);
+    for (int j = 0; j < n; ++j)
+    {
+        double s = 0;
+        for (double x : w[j])
+        {
+            s += x * x;
+        }
+        // Negligible columns were never rotated and have no direction
+        sigma[j] = s < negligible ? 0 : std::sqrt(s);
+        if (sigma[j] != 0)
+        {
+            for (double &x : w[j])
+            {
+                x /= sigma[j];
+            }
+        }
+        sigma[j] = std::ldexp(sigma[j], exponent);
+    }
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int x, int y)
+              { return sigma[x] > sigma[y]; });
+
+    // Columns of zero singular values carry no direction; complete U with
+    // an orthonormal basis of the complement of the nonzero columns
+    Rows u(n);
+    int rank = 0;
+    for (int j = 0; j < n; ++j)
+    {
+        u[j] = std::move(w[order[j]]);
+        rank += sigma[order[j]] != 0;
+    }
+    completeOrthonormal(u, rank);
+
+    SVD result{Matrix<double>(m, n), std::vector<double>(n), Matrix<double>(n, n)};
+    for (int j = 0; j < n; ++j)
+    {
+        int src = order[j];
+        result.S[j] = sigma[src];
+        for (int i = 0; i < m; ++i)
+        {
+            result.U[i][j] = u[j][i];
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            result.V[i][j] = v[src][i];
+        }
+    }
+    return result;
+}
+
+#endif // SPECTRAL_H
@@ -0,0 +1,266 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Parallel.hpp"
+
+// Locale-independent number formatting and parsing with std::to_chars /
+// std::from_chars over large buffers. This is the low-level layer used
+// by Matrix's operator<< and by MatrixIO.hpp.
+
+// Element types written and read as numbers by this module. bool and the
+// character types are excluded: iostreams print them as words or
+// characters, and std::vector<bool> has no contiguous rows.
+template <typename T>
+concept TextNumber = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+                     !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> &&
+                     !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+                     !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+enum class TextFormat
+{
+    Plain,       // Space-separated rows, one row per line
+    Csv,         // Comma-separated rows, one row per line
+    MatrixMarket // Matrix Market array format (column-major)
+};
+
+// Precision that prints the shortest text which reads back to exactly
+// the same value
+constexpr int roundTripPrecision = -1;
+
+struct WriteOptions
+{
+    TextFormat format = TextFormat::Plain;
+    int precision = 2; // Digits after the decimal point, or roundTripPrecision
+    int threads = 0;   // Formatting workers, 0 = one per hardware thread
+};
+
+namespace text_detail
+{
+    // Rows formatted per worker before the buffers are written out; bounds
+    // the memory used for very large matrices
+    constexpr int rowsPerBatch = 64;
+
+    // Longest integer part of a T in fixed notation
+    template <typename T>
+    constexpr int integerDigits = std::is_floating_point_v<T> ? std::numeric_limits<T>::max_exponent10 + 1
+                                                              : std::numeric_limits<T>::digits10 + 1;
+
+    // Room for the sign, the point and a shortest-form exponent
+    constexpr int numberOverhead = 16;
+
+    // Fractional digits that still fit the stack buffer of appendNumber()
+    constexpr int inlinePrecision = 64;
+
+    // Fewest elements per worker when formatting (characters when
+    // parsing) before work is split between threads
+    constexpr int minElementsPerWorker = 1 << 14;
+}
+
+inline bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == '\v' || c == '\f';
+}
+
+// Appends value to out in fixed notation with `precision` fractional
+// digits, or in shortest round-trip form for roundTripPrecision.
+// Integers are always written exactly.
+template <TextNumber T>
+void appendNumber(std::string &out, T value, int precision)
+{
+    constexpr int inlineLength = text_detail::integerDigits<T> + text_detail::numberOverhead + text_detail::inlinePrecision;
+    char local[inlineLength];
+    std::vector<char> large;
+    char *first = local;
+    char *last = local + inlineLength;
+    if (precision > text_detail::inlinePrecision)
+    {
+        large.resize(text_detail::integerDigits<T> + text_detail::numberOverhead + precision);
+        first = large.data();
+        last = first + large.size();
+    }
+    std::to_chars_result result;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        result = precision < 0 ? std::to_chars(first, last, value)
+                               : std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    }
+    else
+    {
+        result = std::to_chars(first, last, value);
+    }
+    if (result.ec != std::errc())
+    {
+        throw std::runtime_error("Could not format matrix element.");
+    }
+    out.append(first, result.ptr);
+}
+
+// Parses [first, last) as one number; the whole range must be consumed
+template <TextNumber T>
+bool parseNumber(const char *first, const char *last, T &value)
+{
+    // from_chars does not accept a leading '+'; it may not be followed by
+    // a second sign
+    if (first != last && *first == '+')
+    {
+        ++first;
+        if (first != last && (*first == '-' || *first == '+'))
+        {
+            return false;
+        }
+    }
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+template <TextNumber T>
+T parseNumber(std::string_view token)
+{
+    T value{};
+    if (!parseNumber(token.data(), token.data() + token.size(), value))
+    {
+        throw std::runtime_error("Invalid matrix element: '" + std::string(token) + "'.");
+    }
+    return value;
+}
+
+// Parses every separator-delimited token of text as a T and calls
+// store(index, value) with its position. Exactly `expected` tokens must
+// be present. The text is cut into one chunk per worker at separator
+// boundaries; a counting pass gives each chunk its first index, and a
+// second pass parses the chunks in parallel.
+template <TextNumber T, typename Store>
+void parseTokens(std::string_view text, std::size_t expected, Store store, int threads = 0)
+{
+    // Offsets are std::size_t: round-trip text of a large matrix can
+    // exceed 2 GiB
+    const std::size_t length = text.size();
+    const char *base = text.data();
+    const std::size_t chunks = length / text_detail::minElementsPerWorker;
+    const int workers = workerCount(0, static_cast<int>(std::min<std::size_t>(chunks, std::numeric_limits<int>::max())), threads, 1);
+
+    std::vector<std::size_t> cut(workers + 1);
+    cut[workers] = length;
+    for (int w = 1; w < workers; ++w)
+    {
+        std::size_t at = std::max(length / workers * w + length % workers * w / workers, cut[w - 1]);
+        while (at < length && !isSeparator(base[at]))
+        {
+            ++at;
+        }
+        cut[w] = at;
+    }
+
+    auto forEachToken = [&](std::size_t from, std::size_t to, auto &&fn)
+    {
+        std::size_t i = from;
+        while (i < to)
+        {
+            while (i < to && isSeparator(base[i]))
+            {
+                ++i;
+            }
+            std::size_t start = i;
+            while (i < to && !isSeparator(base[i]))
+            {
+                ++i;
+            }
+            if (i > start)
+            {
+                fn(start, i);
+            }
+        }
+    };
+
+    std::vector<std::size_t> first(workers + 1);
+    parallelFor(
+        0, workers, [&](int begin, int end, int)
+        {
+            for (int w = begin; w < end; ++w)
+            {
+                std::size_t count = 0;
+                forEachToken(cut[w], cut[w + 1], [&](std::size_t, std::size_t)
+                             { ++count; });
+                first[w + 1] = count;
+            } },
+        workers);
+    for (int w = 0; w < workers; ++w)
+    {
+        first[w + 1] += first[w];
+    }
+    if (first[workers] != expected)
+    {
+        throw std::runtime_error("Expected " + std::to_string(expected) + " matrix elements, found " +
+                                 std::to_string(first[workers]) + ".");
+    }
+
+    parallelFor(
+        0, workers, [&](int begin, int end, int)
+        {
+            for (int w = begin; w < end; ++w)
+            {
+                std::size_t index = first[w];
+                forEachToken(cut[w], cut[w + 1], [&](std::size_t start, std::size_t stop)
+                             { store(index++, parseNumber<T>(std::string_view(base + start, stop - start))); });
+            }
+        },
+        workers);
+}
+
+// Writes `rows` rows of `cols` elements as Plain or Csv text. rowAt(i)
+// returns a pointer to row i. Batches of rows are formatted into one
+// buffer per worker in parallel and then written in order.
+template <TextNumber T, typename RowAt>
+void writeRows(std::ostream &os, int rows, int cols, RowAt rowAt, const WriteOptions &options)
+{
+    const bool csv = options.format == TextFormat::Csv;
+    const int minRows = std::max(1, text_detail::minElementsPerWorker / std::max(cols, 1));
+    const int workers = workerCount(0, rows, options.threads, minRows);
+    const int batch = workers * text_detail::rowsPerBatch;
+    std::vector<std::string> buffers(workers);
+
+    for (int start = 0; start < rows; start += batch)
+    {
+        const int stop = std::min(rows, start + batch);
+        parallelFor(
+            start, stop, [&](int begin, int end, int w)
+            {
+                std::string &out = buffers[w];
+                out.clear();
+                for (int i = begin; i < end; ++i)
+                {
+                    const T *row = rowAt(i);
+                    for (int j = 0; j < cols; ++j)
+                    {
+                        appendNumber(out, row[j], options.precision);
+                        if (!csv)
+                        {
+                            out += ' ';
+                        }
+                        else if (j + 1 < cols)
+                        {
+                            out += ',';
+                        }
+                    }
+                    out += '\n';
+                } },
+            workers, 1);
+        for (int w = 0; w < workers; ++w)
+        {
+            os.write(buffers[w].data(), static_cast<std::streamsize>(buffers[w].size()));
+            buffers[w].clear();
+        }
+    }
+}
+
+#endif // TEXT_FORMAT_H
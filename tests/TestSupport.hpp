@@ -0,0 +1,291 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "../src/Matrix.hpp"
+
+// Shared helpers for the randomized differential tests and benchmarks.
+// Every optimized code path is compared against the naive reference
+// implementations below, which accumulate in long double and make no
+// attempt to be fast.
+
+// Random matrix with small integer entries for integral types and
+// uniformly distributed entries in [-1, 1) for floating point types
+template <typename T>
+Matrix<T> randomMatrix(int rows, int cols, std::mt19937_64 &rng)
+{
+    Matrix<T> m(rows, cols);
+    if constexpr (std::is_integral_v<T>)
+    {
+        std::uniform_int_distribution<int> dist(-9, 9);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                m[i][j] = static_cast<T>(dist(rng));
+    }
+    else
+    {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                m[i][j] = static_cast<T>(dist(rng));
+    }
+    return m;
+}
+
+// Distance between two floating point values in units in the last place
+template <typename T>
+std::uint64_t ulpDistance(T a, T b)
+{
+    static_assert(std::is_floating_point_v<T>, "ULP distance is only defined for floating point types");
+    using Bits = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+    if (a == b)
+        return 0;
+    if (std::isnan(a) || std::isnan(b))
+        return std::numeric_limits<std::uint64_t>::max();
+    Bits ia, ib;
+    std::memcpy(&ia, &a, sizeof(T));
+    std::memcpy(&ib, &b, sizeof(T));
+    // Map the sign-magnitude representation onto a monotonic integer line
+    if (ia < 0)
+        ia = std::numeric_limits<Bits>::min() - ia;
+    if (ib < 0)
+        ib = std::numeric_limits<Bits>::min() - ib;
+    return ia > ib ? static_cast<std::uint64_t>(ia) - static_cast<std::uint64_t>(ib)
+                   : static_cast<std::uint64_t>(ib) - static_cast<std::uint64_t>(ia);
+}
+
+// Compares a computed value against a long double reference. Integral
+// types must match the rounded reference exactly. Floating point values must either be within
+// maxUlps of the rounded reference, or (to cover cancellation in sums)
+// within maxUlps * epsilon of the magnitude `scale` of the terms that
+// produced the reference.
+template <typename T>
+bool closeTo(T got, long double ref, long double scale, std::uint64_t maxUlps)
+{
+    if constexpr (std::is_integral_v<T>)
+    {
+        return static_cast<long long>(got) == std::llround(ref);
+    }
+    else
+    {
+        T rounded = static_cast<T>(ref);
+        if (ulpDistance(got, rounded) <= maxUlps)
+            return true;
+        long double eps = std::numeric_limits<T>::epsilon();
+        return std::fabs(static_cast<long double>(got) - ref) <= maxUlps * eps * scale;
+    }
+}
+
+// Reference (naive) implementations
+template <typename T>
+std::vector<std::vector<long double>> referenceMultiply(const Matrix<T> &a, const Matrix<T> &b,
+                                                        std::vector<std::vector<long double>> *scale = nullptr)
+{
+    std::vector<std::vector<long double>> c(a.rows(), std::vector<long double>(b.cols()));
+    if (scale)
+        *scale = c;
+    for (int i = 0; i < a.rows(); ++i)
+        for (int j = 0; j < b.cols(); ++j)
+            for (int k = 0; k < a.cols(); ++k)
+            {
+                long double term = static_cast<long double>(a[i][k]) * b[k][j];
+                c[i][j] += term;
+                if (scale)
+                    (*scale)[i][j] += std::fabs(term);
+            }
+    return c;
+}
+
+// a^e by e - 1 naive multiplications in long double; *scale receives
+// |a|^e, the magnitude of the terms that produced each entry
+template <typename T>
+std::vector<std::vector<long double>> referencePower(const Matrix<T> &a, int e,
+                                                     std::vector<std::vector<long double>> *scale = nullptr)
+{
+    int n = a.rows();
+    std::vector<std::vector<long double>> p(n, std::vector<long double>(n)), s = p;
+    for (int i = 0; i < n; ++i)
+        p[i][i] = s[i][i] = 1;
+    for (int step = 0; step < e; ++step)
+    {
+        std::vector<std::vector<long double>> np(n, std::vector<long double>(n)), ns = np;
+        for (int i = 0; i < n; ++i)
+            for (int k = 0; k < n; ++k)
+                for (int j = 0; j < n; ++j)
+                {
+                    long double x = a[k][j];
+                    np[i][j] += p[i][k] * x;
+                    ns[i][j] += s[i][k] * std::fabs(x);
+                }
+        p = np;
+        s = ns;
+    }
+    if (scale)
+        *scale = s;
+    return p;
+}
+
+// Determinant by Gaussian elimination with partial pivoting in long
+// double; deliberately a different algorithm from Matrix::determinant()
+template <typename T>
+long double referenceDeterminant(const Matrix<T> &m)
+{
+    int n = m.rows();
+    std::vector<std::vector<long double>> a(n, std::vector<long double>(n));
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            a[i][j] = m[i][j];
+    long double det = 1;
+    for (int k = 0; k < n; ++k)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; ++i)
+            if (std::fabs(a[i][k]) > std::fabs(a[pivot][k]))
+                pivot = i;
+        if (a[pivot][k] == 0)
+            return 0;
+        if (pivot != k)
+        {
+            std::swap(a[pivot], a[k]);
+            det = -det;
+        }
+        det *= a[k][k];
+        for (int i = k + 1; i < n; ++i)
+        {
+            long double f = a[i][k] / a[k][k];
+            for (int j = k; j < n; ++j)
+                a[i][j] -= f * a[k][j];
+        }
+    }
+    return det;
+}
+
+// Solution of the square system a * x = b by Gaussian elimination with
+// partial pivoting in long double
+inline std::vector<long double> referenceSolve(std::vector<std::vector<long double>> a, std::vector<long double> b)
+{
+    int n = static_cast<int>(a.size());
+    for (int k = 0; k < n; ++k)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; ++i)
+            if (std::fabs(a[i][k]) > std::fabs(a[pivot][k]))
+                pivot = i;
+        std::swap(a[pivot], a[k]);
+        std::swap(b[pivot], b[k]);
+        for (int i = k + 1; i < n; ++i)
+        {
+            long double f = a[i][k] / a[k][k];
+            for (int j = k; j < n; ++j)
+                a[i][j] -= f * a[k][j];
+            b[i] -= f * b[k];
+        }
+    }
+    std::vector<long double> x(n);
+    for (int i = n - 1; i >= 0; --i)
+    {
+        long double s = b[i];
+        for (int j = i + 1; j < n; ++j)
+            s -= a[i][j] * x[j];
+        x[i] = s / a[i][i];
+    }
+    return x;
+}
+
+// Least squares solution of a * x = b from the normal equations in long double
+inline std::vector<long double> referenceLeastSquares(const Matrix<double> &a, const std::vector<double> &b)
+{
+    int m = a.rows(), n = a.cols();
+    std::vector<std::vector<long double>> ata(n, std::vector<long double>(n));
+    std::vector<long double> atb(n);
+    for (int i = 0; i < m; ++i)
+        for (int j = 0; j < n; ++j)
+        {
+            atb[j] += static_cast<long double>(a[i][j]) * b[i];
+            for (int k = 0; k < n; ++k)
+                ata[j][k] += static_cast<long double>(a[i][j]) * a[i][k];
+        }
+    return referenceSolve(ata, atb);
+}
+
+// Eigenvalues of the symmetric matrix m in ascending order by the cyclic
+// Jacobi method in long double; slow but simple and very accurate
+inline std::vector<long double> referenceSymmetricEigenvalues(const Matrix<double> &m)
+{
+    int n = m.rows();
+    std::vector<std::vector<long double>> a(n, std::vector<long double>(n));
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            a[i][j] = m[i][j];
+    for (int sweep = 0; sweep < 100; ++sweep)
+    {
+        long double off = 0, total = 0;
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+            {
+                total += a[i][j] * a[i][j];
+                if (i != j)
+                    off += a[i][j] * a[i][j];
+            }
+        if (off <= 1e-36L * total)
+            break;
+        for (int p = 0; p < n; ++p)
+            for (int q = p + 1; q < n; ++q)
+            {
+                if (a[p][q] == 0)
+                    continue;
+                long double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                long double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                long double c = 1 / std::sqrt(t * t + 1), s = t * c;
+                for (int k = 0; k < n; ++k)
+                {
+                    long double x = a[k][p], y = a[k][q];
+                    a[k][p] = c * x - s * y;
+                    a[k][q] = s * x + c * y;
+                }
+                for (int k = 0; k < n; ++k)
+                {
+                    long double x = a[p][k], y = a[q][k];
+                    a[p][k] = c * x - s * y;
+                    a[q][k] = s * x + c * y;
+                }
+            }
+    }
+    std::vector<long double> values(n);
+    for (int i = 0; i < n; ++i)
+        values[i] = a[i][i];
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// Largest absolute entry of a - b
+template <typename T>
+long double maxAbsDifference(const Matrix<T> &a, const Matrix<T> &b)
+{
+    long double worst = 0;
+    for (int i = 0; i < a.rows(); ++i)
+        for (int j = 0; j < a.cols(); ++j)
+            worst = std::max(worst, std::fabs(static_cast<long double>(a[i][j]) - b[i][j]));
+    return worst;
+}
+
+template <typename T>
+const char *typeName()
+{
+    if constexpr (std::is_same_v<T, int>)
+        return "int";
+    else if constexpr (std::is_same_v<T, float>)
+        return "float";
+    else
+        return "double";
+}
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <sstream>
+#include <cstdlib>
+#include "TestSupport.hpp"
+#include "../src/Reductions.hpp"
+#include "../src/Spectral.hpp"
+#include "../src/Factorizations.hpp"
+#include "../src/MatrixIO.hpp"
+
+using namespace std;
+
+// Performance regression checks. Usage: bench_matrix [min_gflops]
+// Each kernel is timed (best of a few runs) and the run fails if the
+// throughput of the 1024x1024 GEMM falls below min_gflops.
+
+template <typename F>
+double bestSeconds(F &&f, int repeats)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+    }
+    return best;
+}
+
+double benchMultiply(int n, int repeats, mt19937_64 &rng)
+{
+    Matrix<double> a = randomMatrix<double>(n, n, rng);
+    Matrix<double> b = randomMatrix<double>(n, n, rng);
+    double seconds = bestSeconds([&]
+                                 { Matrix<double> c = a * b; },
+                                 repeats);
+    double gflops = 2.0 * n * n * n / seconds * 1e-9;
+    cout << "multiply " << setw(5) << n << "x" << left << setw(5) << n << right
+         << fixed << setprecision(3) << setw(10) << seconds * 1e3 << " ms "
+         << setw(8) << gflops << " GFLOP/s" << endl;
+    return gflops;
+}
+
+template <typename F>
+void benchReduction(const char *name, const Matrix<double> &a, F &&f)
+{
+    double seconds = bestSeconds(f, 5);
+    double gbs = double(a.rows()) * a.cols() * sizeof(double) / seconds * 1e-9;
+    cout << left << setw(16) << name << right << fixed << setprecision(3) << setw(10) << seconds * 1e3
+         << " ms " << setw(8) << gbs << " GB/s" << endl;
+}
+
+void benchReductions(int n, mt19937_64 &rng)
+{
+    Matrix<double> a = randomMatrix<double>(n, n, rng);
+    volatile double sink = 0;
+    cout << "reductions on " << n << "x" << n << endl;
+    benchReduction("sum", a, [&]
+                   { sink = sum(a); });
+    benchReduction("sum (1 thread)", a, [&]
+                   { sink = sum(a, 1); });
+    benchReduction("colSums", a, [&]
+                   { sink = colSums(a)[0]; });
+    benchReduction("frobeniusNorm", a, [&]
+                   { sink = frobeniusNorm(a); });
+    benchReduction("norm1", a, [&]
+                   { sink = norm1(a); });
+    (void)sink;
+}
+
+template <typename F>
+void benchDecomposition(const char *name, int n, F &&f)
+{
+    double seconds = bestSeconds(f, 1);
+    cout << left << setw(16) << name << right << setw(5) << n << "x" << left << setw(5) << n << right
+         << fixed << setprecision(3) << setw(10) << seconds * 1e3 << " ms" << endl;
+}
+
+void benchSpectral(int n, mt19937_64 &rng)
+{
+    Matrix<double> a = randomMatrix<double>(n, n, rng);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < i; ++j)
+            a[j][i] = a[i][j];
+    benchDecomposition("symmetricEigen", n, [&]
+                       { symmetricEigen(a); });
+    benchDecomposition("eigenvalues", n, [&]
+                       { eigenvalues(a); });
+    benchDecomposition("svd", n, [&]
+                       { svd(a); });
+
+    // Blocked tridiagonal reduction against the unblocked one (panel width 1)
+    const int big = 4 * n;
+    Matrix<double> b = randomMatrix<double>(big, big, rng);
+    for (int block : {1, spectral_detail::tridiagonalBlock})
+    {
+        spectral_detail::Rows upper(big, vector<double>(big));
+        for (int i = 0; i < big; ++i)
+            for (int j = i; j < big; ++j)
+                upper[i][j] = b[i][j];
+        vector<double> d, e;
+        benchDecomposition(block == 1 ? "tridiag nb 1" : "tridiag nb 32", big, [&]
+                           { spectral_detail::tridiagonalize(upper, d, e, 0, block); });
+    }
+}
+
+// Blocked factorizations against their unblocked kernels (block size >= n)
+void benchFactorizations(int n, mt19937_64 &rng)
+{
+    Matrix<double> b = randomMatrix<double>(n, n, rng);
+    Matrix<double> spd = b * b.transpose() + Matrix<double>::identity(n) * n;
+    Matrix<double> tall = randomMatrix<double>(2 * n, n, rng);
+    auto report = [&](const char *name, double flops, double seconds)
+    {
+        cout << left << setw(20) << name << right << fixed << setprecision(3) << setw(10) << seconds * 1e3
+             << " ms " << setw(8) << flops / seconds * 1e-9 << " GFLOP/s" << endl;
+    };
+    double cholFlops = n * double(n) * n / 3;
+    double qrFlops = 2.0 * n * n * (2 * n - n / 3.0);
+    cout << "factorizations of " << n << "x" << n << " (Cholesky) and " << 2 * n << "x" << n << " (QR)" << endl;
+    report("cholesky unblocked", cholFlops, bestSeconds([&]
+                                                        { Cholesky c(spd, n); }, 1));
+    report("cholesky blocked", cholFlops, bestSeconds([&]
+                                                      { Cholesky c(spd); }, 1));
+    report("qr unblocked", qrFlops, bestSeconds([&]
+                                                { QR q(tall, n); }, 1));
+    report("qr blocked", qrFlops, bestSeconds([&]
+                                              { QR q(tall); }, 1));
+}
+
+// Multiply with pinned workers spread over the nodes, for each way of
+// placing the operands' rows. Caller puts every row on the calling
+// thread's node, so on a multi-node host other nodes read remotely.
+void benchPlacement(int n, mt19937_64 &rng)
+{
+    Matrix<double> a0 = randomMatrix<double>(n, n, rng), b0 = randomMatrix<double>(n, n, rng);
+    cout << "placement with scattered pinning, " << numaTopology().nodes() << " NUMA node(s), "
+         << defaultThreads() << " thread(s)" << endl;
+    setPinning(Pinning::Scatter);
+    const pair<const char *, Placement> policies[] = {
+        {"caller (remote)", Placement::Caller},
+        {"first touch", Placement::FirstTouch},
+        {"interleave", Placement::Interleave}};
+    for (const auto &[name, policy] : policies)
+    {
+        setPlacement(policy);
+        // Copy into freshly placed rows
+        Matrix<double> a = a0 + Matrix<double>(n, n), b = b0 + Matrix<double>(n, n);
+        double seconds = bestSeconds([&]
+                                     { Matrix<double> c = a * b; },
+                                     1);
+        cout << left << setw(16) << name << right << fixed << setprecision(3) << setw(10) << seconds * 1e3
+             << " ms " << setw(8) << 2.0 * n * n * n / seconds * 1e-9 << " GFLOP/s" << endl;
+    }
+    setPlacement(Placement::FirstTouch);
+    setPinning(Pinning::None);
+}
+
+// Text output and input of an n x n matrix: the iostream element loop
+// the calculator used before against the to_chars / from_chars paths
+void benchTextIO(int n, mt19937_64 &rng)
+{
+    Matrix<double> a = randomMatrix<double>(n, n, rng);
+    string text;
+    auto report = [&](const char *name, double seconds)
+    {
+        cout << left << setw(22) << name << right << fixed << setprecision(3) << setw(10) << seconds * 1e3
+             << " ms " << setw(8) << text.size() / seconds * 1e-6 << " MB/s" << endl;
+    };
+    cout << "text I/O of " << n << "x" << n << endl;
+    report("write iostream", bestSeconds([&]
+                                         {
+        ostringstream os;
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+                os << fixed << setprecision(2) << a[i][j] << " ";
+            os << endl;
+        }
+        text = os.str(); }, 1));
+    report("write to_chars", bestSeconds([&]
+                                         { text = formatMatrix(a); }, 1));
+    report("read iostream", bestSeconds([&]
+                                        {
+        istringstream is(text);
+        Matrix<double> b(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                is >> b[i][j]; }, 1));
+    report("read from_chars", bestSeconds([&]
+                                          { parseMatrix<double>(text, n, n); }, 1));
+    report("read stream", bestSeconds([&]
+                                      {
+        istringstream is(text);
+        readMatrix<double>(is, n, n); }, 1));
+    report("write round trip", bestSeconds([&]
+                                           { text = formatMatrix(a, {TextFormat::Plain, roundTripPrecision}); }, 1));
+}
+
+int main(int argc, char **argv)
+{
+    double minGflops = argc > 1 ? strtod(argv[1], nullptr) : 0.0;
+    mt19937_64 rng(42);
+
+    benchMultiply(128, 5, rng);
+    benchMultiply(256, 3, rng);
+    benchMultiply(512, 2, rng);
+    double gemm = benchMultiply(1024, 1, rng);
+    benchReductions(2048, rng);
+    benchSpectral(256, rng);
+    benchFactorizations(1024, rng);
+    benchPlacement(1024, rng);
+    benchTextIO(2000, rng);
+
+    if (gemm < minGflops)
+    {
+        cerr << "FAILED: 1024x1024 multiply reached " << gemm << " GFLOP/s, expected >= " << minGflops << endl;
+        return 1;
+    }
+    cout << "All performance assertions passed!" << endl;
+    return 0;
+}
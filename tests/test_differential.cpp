@@ -0,0 +1,611 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <iomanip>
+#include <complex>
+#include <sstream>
+#include <limits>
+#include "TestSupport.hpp"
+#include "../src/Reductions.hpp"
+#include "../src/Spectral.hpp"
+#include "../src/Factorizations.hpp"
+#include "../src/MatrixIO.hpp"
+
+using namespace std;
+
+// Randomized differential tests: every Matrix operation is run on random
+// shapes and element types and compared with the reference
+// implementations in TestSupport.hpp. Pass a seed as the first argument
+// to reproduce a failure.
+
+static unsigned long long seed = 20240501ULL;
+
+// Thread counts swept by the tests of threaded kernels
+static const int threadCounts[] = {1, 2, 3, 4, 8};
+
+// Block sizes swept by the tests of blocked factorizations; 1 << 20 runs
+// the unblocked kernel on the whole matrix
+static const int blockSizes[] = {1, 3, 16, 64, 1 << 20};
+static int failures = 0;
+
+static void report(const char *test, const char *type, int rows, int cols, int i, int j)
+{
+    cerr << "FAILED " << test << "<" << type << "> " << rows << "x" << cols
+         << " at (" << i << ", " << j << "), seed " << seed << endl;
+    ++failures;
+}
+
+template <typename T>
+void testElementwise(mt19937_64 &rng, int trials)
+{
+    uniform_int_distribution<int> dim(1, 64);
+    for (int t = 0; t < trials; ++t)
+    {
+        int r = dim(rng), c = dim(rng);
+        Matrix<T> a = randomMatrix<T>(r, c, rng);
+        Matrix<T> b = randomMatrix<T>(r, c, rng);
+        T s = randomMatrix<T>(1, 1, rng)[0][0];
+        Matrix<T> sum = a + b, diff = a - b, scaled = a * s, tr = a.transpose();
+        assert(tr.rows() == c && tr.cols() == r);
+        // Allow one ULP for double rounding through the long double reference
+        for (int i = 0; i < r; ++i)
+        {
+            for (int j = 0; j < c; ++j)
+            {
+                long double x = a[i][j], y = b[i][j];
+                if (!closeTo(sum[i][j], x + y, fabsl(x) + fabsl(y), 1))
+                    report("add", typeName<T>(), r, c, i, j);
+                if (!closeTo(diff[i][j], x - y, fabsl(x) + fabsl(y), 1))
+                    report("subtract", typeName<T>(), r, c, i, j);
+                if (!closeTo(scaled[i][j], x * s, fabsl(x * s), 1))
+                    report("scale", typeName<T>(), r, c, i, j);
+                if (tr[j][i] != a[i][j])
+                    report("transpose", typeName<T>(), r, c, i, j);
+            }
+        }
+    }
+}
+
+template <typename T>
+void testMultiply(mt19937_64 &rng, int trials)
+{
+    uniform_int_distribution<int> dim(1, 96);
+    for (int t = 0; t < trials; ++t)
+    {
+        // operator* has no thread argument, so sweep the default instead
+        setDefaultThreads(threadCounts[t % size(threadCounts)]);
+        int m = dim(rng), k = dim(rng), n = dim(rng);
+        Matrix<T> a = randomMatrix<T>(m, k, rng);
+        Matrix<T> b = randomMatrix<T>(k, n, rng);
+        Matrix<T> c = a * b;
+        vector<vector<long double>> scale;
+        vector<vector<long double>> ref = referenceMultiply(a, b, &scale);
+        assert(c.rows() == m && c.cols() == n);
+        // Recursive summation error grows at most linearly with k
+        for (int i = 0; i < m; ++i)
+            for (int j = 0; j < n; ++j)
+                if (!closeTo(c[i][j], ref[i][j], scale[i][j], 2 * k))
+                    report("multiply", typeName<T>(), m, n, i, j);
+    }
+    setDefaultThreads(0);
+}
+
+template <typename T>
+void testPower(mt19937_64 &rng, int trials)
+{
+    // Keep integer powers small enough not to overflow
+    uniform_int_distribution<int> dim(1, is_integral_v<T> ? 6 : 24), exp(0, 5);
+    for (int t = 0; t < trials; ++t)
+    {
+        int n = dim(rng), e = exp(rng);
+        Matrix<T> a = randomMatrix<T>(n, n, rng);
+        Matrix<T> p = a.power(e);
+        vector<vector<long double>> scale;
+        vector<vector<long double>> ref = referencePower(a, e, &scale);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                if (!closeTo(p[i][j], ref[i][j], scale[i][j], 4 * n * (e + 1)))
+                    report("power", typeName<T>(), n, n, i, j);
+    }
+}
+
+template <typename T>
+void testDeterminant(mt19937_64 &rng, int trials)
+{
+    // Cofactor expansion is O(n!), so keep n small
+    uniform_int_distribution<int> dim(1, 7);
+    for (int t = 0; t < trials; ++t)
+    {
+        int n = dim(rng);
+        Matrix<T> a = randomMatrix<T>(n, n, rng);
+        // Hadamard's bound on |det| is the natural scale for the error
+        long double hadamard = 1;
+        for (int i = 0; i < n; ++i)
+        {
+            long double norm = 0;
+            for (int j = 0; j < n; ++j)
+                norm += static_cast<long double>(a[i][j]) * a[i][j];
+            hadamard *= sqrtl(norm);
+        }
+        if (!closeTo(a.determinant(), referenceDeterminant(a), hadamard, 64 * n))
+            report("determinant", typeName<T>(), n, n, 0, 0);
+    }
+}
+
+template <typename T>
+void testReductions(mt19937_64 &rng, int trials)
+{
+    // Large enough that the threaded kernels split the rows between workers
+    uniform_int_distribution<int> dim(1, 600);
+    for (int threads : threadCounts)
+    {
+        for (int t = 0; t < trials; ++t)
+        {
+            int r = dim(rng), c = dim(rng);
+            Matrix<T> a = randomMatrix<T>(r, c, rng);
+            vector<long double> rowRef(r), rowAbs(r), colRef(c), colAbs(c);
+            long double total = 0, totalAbs = 0, squares = 0;
+            T lo = a[0][0], hi = a[0][0];
+            for (int i = 0; i < r; ++i)
+                for (int j = 0; j < c; ++j)
+                {
+                    long double x = a[i][j];
+                    rowRef[i] += x;
+                    rowAbs[i] += fabsl(x);
+                    colRef[j] += x;
+                    colAbs[j] += fabsl(x);
+                    squares += x * x;
+                    lo = min(lo, a[i][j]);
+                    hi = max(hi, a[i][j]);
+                }
+            for (int i = 0; i < r; ++i)
+            {
+                total += rowRef[i];
+                totalAbs += rowAbs[i];
+            }
+
+            // Pairwise and compensated sums stay within a few ULPs of the
+            // magnitude of the summands
+            vector<T> rs = rowSums(a, threads), cs = colSums(a, threads);
+            vector<T> rmin = rowMins(a, threads), rmax = rowMaxs(a, threads);
+            vector<T> cmin = colMins(a, threads), cmax = colMaxs(a, threads);
+            for (int i = 0; i < r; ++i)
+            {
+                if (!closeTo(rs[i], rowRef[i], rowAbs[i], 16))
+                    report("rowSums", typeName<T>(), r, c, i, 0);
+                if (rmin[i] != *min_element(a[i].begin(), a[i].end()) ||
+                    rmax[i] != *max_element(a[i].begin(), a[i].end()))
+                    report("rowMins/rowMaxs", typeName<T>(), r, c, i, 0);
+            }
+            for (int j = 0; j < c; ++j)
+            {
+                if (!closeTo(cs[j], colRef[j], colAbs[j], 4))
+                    report("colSums", typeName<T>(), r, c, 0, j);
+                T cl = a[0][j], ch = a[0][j];
+                for (int i = 1; i < r; ++i)
+                {
+                    cl = min(cl, a[i][j]);
+                    ch = max(ch, a[i][j]);
+                }
+                if (cmin[j] != cl || cmax[j] != ch)
+                    report("colMins/colMaxs", typeName<T>(), r, c, 0, j);
+            }
+            if (!closeTo(sum(a, threads), total, totalAbs, 32))
+                report("sum", typeName<T>(), r, c, 0, 0);
+            if (minElement(a, threads) != lo || maxElement(a, threads) != hi)
+                report("minElement/maxElement", typeName<T>(), r, c, 0, 0);
+
+            using R = NormType<T>;
+            long double ref1 = *max_element(colAbs.begin(), colAbs.end());
+            long double refInf = *max_element(rowAbs.begin(), rowAbs.end());
+            if (!closeTo<R>(norm1(a, threads), ref1, ref1, 4))
+                report("norm1", typeName<T>(), r, c, 0, 0);
+            if (!closeTo<R>(normInf(a, threads), refInf, refInf, 16))
+                report("normInf", typeName<T>(), r, c, 0, 0);
+            if (!closeTo<R>(frobeniusNorm(a, threads), sqrtl(squares), sqrtl(squares), 32))
+                report("frobeniusNorm", typeName<T>(), r, c, 0, 0);
+
+            // Squares of these entries overflow or underflow T, but the
+            // norm itself is representable
+            if constexpr (is_floating_point_v<T>)
+            {
+                const T factors[] = {numeric_limits<T>::max() / 1024, numeric_limits<T>::min(),
+                                     numeric_limits<T>::denorm_min() * (1 << 20)};
+                for (T factor : factors)
+                {
+                    Matrix<T> b = a * factor;
+                    long double scaled = 0;
+                    for (int i = 0; i < r; ++i)
+                        for (int j = 0; j < c; ++j)
+                            scaled += static_cast<long double>(b[i][j]) * b[i][j];
+                    if (!closeTo<R>(frobeniusNorm(b, threads), sqrtl(scaled), sqrtl(scaled), 32))
+                        report("frobeniusNorm (extreme)", typeName<T>(), r, c, 0, 0);
+                }
+            }
+        }
+    }
+}
+
+// Random orthogonal (Householder) matrix
+Matrix<double> randomReflector(int n, mt19937_64 &rng)
+{
+    Matrix<double> v = randomMatrix<double>(n, 1, rng);
+    double vv = 0;
+    for (int i = 0; i < n; ++i)
+        vv += v[i][0] * v[i][0];
+    Matrix<double> h = Matrix<double>::identity(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            h[i][j] -= 2 * v[i][0] * v[j][0] / vv;
+    return h;
+}
+
+// Largest entry of |Q^T Q - I| over the first `cols` columns
+double orthogonalityError(const Matrix<double> &q, int cols)
+{
+    double worst = 0;
+    for (int a = 0; a < cols; ++a)
+        for (int b = 0; b < cols; ++b)
+        {
+            double dot = 0;
+            for (int i = 0; i < q.rows(); ++i)
+                dot += q[i][a] * q[i][b];
+            worst = max(worst, fabs(dot - (a == b ? 1.0 : 0.0)));
+        }
+    return worst;
+}
+
+void checkSymmetricEigen(const Matrix<double> &a, int threads, const char *test, int block = 32)
+{
+    const int n = a.rows();
+    const double eps = numeric_limits<double>::epsilon();
+    const double norm = max(frobeniusNorm(a), 1e-300);
+    SymmetricEigen e = symmetricEigen(a, threads, block);
+    vector<long double> ref = referenceSymmetricEigenvalues(a);
+    for (int i = 0; i < n; ++i)
+        if (fabsl(e.values[i] - ref[i]) > 64 * n * eps * norm)
+            report(test, "double", n, n, i, i);
+    Matrix<double> lambda(n, n);
+    for (int i = 0; i < n; ++i)
+        lambda[i][i] = e.values[i];
+    if (maxAbsDifference(a * e.vectors, e.vectors * lambda) > 64 * n * eps * norm)
+        report(test, "double", n, n, -1, -1);
+    if (orthogonalityError(e.vectors, n) > 64 * n * eps)
+        report(test, "double", n, n, -2, -2);
+}
+
+void testSymmetricEigen(mt19937_64 &rng, int trials)
+{
+    // Sizes above 32 go through divide and conquer
+    uniform_int_distribution<int> dim(1, 160);
+    int sweep = 0;
+    for (int threads : threadCounts)
+    {
+        for (int t = 0; t < trials; ++t)
+        {
+            int n = dim(rng);
+            Matrix<double> a = randomMatrix<double>(n, n, rng);
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < i; ++j)
+                    a[j][i] = a[i][j];
+            // Sweep the panel width of the blocked tridiagonal reduction
+            int block = blockSizes[sweep++ % size(blockSizes)];
+            checkSymmetricEigen(a, threads, "symmetricEigen", block);
+
+            // Heavily repeated eigenvalues exercise deflation
+            Matrix<double> d(n, n);
+            for (int i = 0; i < n; ++i)
+                d[i][i] = i % 3;
+            Matrix<double> h = randomReflector(n, rng);
+            checkSymmetricEigen(h * d * h, threads, "symmetricEigen (repeated)", block);
+        }
+        checkSymmetricEigen(Matrix<double>::identity(100), threads, "symmetricEigen (identity)");
+    }
+}
+
+void testGeneralEigenvalues(mt19937_64 &rng, int trials)
+{
+    // Quasi-triangular matrices with known eigenvalues in random orthogonal
+    // coordinates; real parts are kept distinct so the sorted order is stable
+    uniform_int_distribution<int> dim(1, 80);
+    uniform_real_distribution<double> coupling(-1, 1), imag(0.5, 2);
+    const double eps = numeric_limits<double>::epsilon();
+    for (int threads : threadCounts)
+    {
+        for (int t = 0; t < trials; ++t)
+        {
+            int n = dim(rng);
+            Matrix<double> b(n, n);
+            vector<complex<double>> expected;
+            for (int i = 0; i < n; ++i)
+            {
+                double re = i - n / 2.0;
+                if (i + 1 < n && rng() % 2)
+                {
+                    double im = imag(rng);
+                    b[i][i] = b[i + 1][i + 1] = re;
+                    b[i][i + 1] = -im;
+                    b[i + 1][i] = im;
+                    expected.push_back({re, -im});
+                    expected.push_back({re, im});
+                    ++i;
+                }
+                else
+                {
+                    b[i][i] = re;
+                    expected.push_back({re, 0});
+                }
+            }
+            for (int i = 0; i < n; ++i)
+                for (int j = i + 2; j < n; ++j)
+                    b[i][j] = coupling(rng);
+            Matrix<double> h = randomReflector(n, rng);
+            Matrix<double> a = h * b * h;
+            vector<complex<double>> got = eigenvalues(a, threads);
+            for (int i = 0; i < n; ++i)
+                if (abs(got[i] - expected[i]) > 1e4 * n * eps * max(frobeniusNorm(a), 1.0))
+                    report("eigenvalues", "double", n, n, i, i);
+        }
+    }
+}
+
+void checkSVD(const Matrix<double> &a, int threads, const char *test)
+{
+    const int m = a.rows(), n = a.cols(), r = min(m, n);
+    const double eps = numeric_limits<double>::epsilon();
+    const double norm = frobeniusNorm(a);
+    SVD d = svd(a, threads);
+    assert(d.U.rows() == m && d.U.cols() == r);
+    assert(d.V.rows() == n && d.V.cols() == r);
+    Matrix<double> us = d.U;
+    for (int i = 0; i < m; ++i)
+        for (int j = 0; j < r; ++j)
+            us[i][j] *= d.S[j];
+    if (maxAbsDifference(us * d.V.transpose(), a) > 64 * max(m, n) * eps * norm)
+        report(test, "double", m, n, -1, -1);
+    if (orthogonalityError(d.U, r) > 64 * max(m, n) * eps || orthogonalityError(d.V, r) > 64 * max(m, n) * eps)
+        report(test, "double", m, n, -2, -2);
+    // Squared singular values are the eigenvalues of the Gram matrix
+    vector<long double> gram = referenceSymmetricEigenvalues(m >= n ? a.transpose() * a : a * a.transpose());
+    for (int i = 0; i < r; ++i)
+    {
+        if (i > 0 && d.S[i] > d.S[i - 1])
+            report(test, "double", m, n, i, i);
+        if (fabsl(static_cast<long double>(d.S[i]) * d.S[i] - gram[r - 1 - i]) > 64 * max(m, n) * eps * norm * norm)
+            report(test, "double", m, n, i, i);
+    }
+}
+
+void testSVD(mt19937_64 &rng, int trials)
+{
+    uniform_int_distribution<int> dim(1, 120);
+    for (int threads : threadCounts)
+    {
+        for (int t = 0; t < trials; ++t)
+        {
+            int m = dim(rng), n = dim(rng);
+            checkSVD(randomMatrix<double>(m, n, rng), threads, "svd");
+
+            // Rank-deficient: a low-rank product, and zero columns (or rows)
+            // whose singular values are exactly 0
+            uniform_int_distribution<int> rank(1, max(1, min(m, n) - 1));
+            int k = rank(rng);
+            checkSVD(randomMatrix<double>(m, k, rng) * randomMatrix<double>(k, n, rng), threads, "svd low rank");
+            Matrix<double> zeroed = randomMatrix<double>(m, n, rng);
+            for (int j = 0; j < n; j += 2)
+                for (int i = 0; i < m; ++i)
+                    zeroed[i][j] = 0;
+            checkSVD(zeroed, threads, "svd zero columns");
+            checkSVD(zeroed.transpose(), threads, "svd zero rows");
+        }
+    }
+}
+
+void testCholesky(mt19937_64 &rng, int trials)
+{
+    uniform_int_distribution<int> dim(1, 150), rhs(1, 5);
+    const double eps = numeric_limits<double>::epsilon();
+    for (int threads : threadCounts)
+    {
+        for (int block : blockSizes)
+        {
+            for (int t = 0; t < trials; ++t)
+            {
+                // B * B^T + n * I is symmetric positive definite and well conditioned
+                int n = dim(rng), p = rhs(rng);
+                Matrix<double> b = randomMatrix<double>(n, n, rng);
+                Matrix<double> a = b * b.transpose() + Matrix<double>::identity(n) * n;
+                const double norm = frobeniusNorm(a);
+                Cholesky chol(a, block, threads);
+                Matrix<double> l = chol.L();
+                for (int i = 0; i < n; ++i)
+                    for (int j = i + 1; j < n; ++j)
+                        if (l[i][j] != 0)
+                            report("cholesky triangle", "double", n, n, i, j);
+                if (maxAbsDifference(l * l.transpose(), a) > 16 * n * eps * norm)
+                    report("cholesky reconstruction", "double", n, n, -1, -1);
+
+                Matrix<double> rhsMatrix = randomMatrix<double>(n, p, rng);
+                Matrix<double> x = chol.solve(rhsMatrix, threads);
+                for (int c = 0; c < p; ++c)
+                {
+                    vector<vector<long double>> al(n, vector<long double>(n));
+                    vector<long double> bl(n);
+                    vector<double> bc(n);
+                    for (int i = 0; i < n; ++i)
+                    {
+                        for (int j = 0; j < n; ++j)
+                            al[i][j] = a[i][j];
+                        bl[i] = bc[i] = rhsMatrix[i][c];
+                    }
+                    vector<long double> ref = referenceSolve(al, bl);
+                    vector<double> xv = chol.solve(bc);
+                    for (int i = 0; i < n; ++i)
+                    {
+                        if (fabsl(x[i][c] - ref[i]) > 64 * n * eps * max(fabsl(ref[i]), 1.0L) ||
+                            fabsl(xv[i] - ref[i]) > 64 * n * eps * max(fabsl(ref[i]), 1.0L))
+                            report("cholesky solve", "double", n, p, i, c);
+                    }
+                }
+            }
+        }
+    }
+
+    bool threw = false;
+    try
+    {
+        Cholesky chol(Matrix<double>({{1, 2}, {2, 1}}));
+    }
+    catch (const runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void testQR(mt19937_64 &rng, int trials)
+{
+    uniform_int_distribution<int> dim(1, 120);
+    const double eps = numeric_limits<double>::epsilon();
+    for (int threads : threadCounts)
+    {
+        for (int block : blockSizes)
+        {
+            for (int t = 0; t < trials; ++t)
+            {
+                int m = dim(rng), n = dim(rng), r = min(m, n);
+                Matrix<double> a = randomMatrix<double>(m, n, rng);
+                const double norm = frobeniusNorm(a);
+                QR qr(a, block, threads);
+                Matrix<double> q = qr.Q(), rf = qr.R();
+                assert(q.rows() == m && q.cols() == r && rf.rows() == r && rf.cols() == n);
+                if (maxAbsDifference(q * rf, a) > 16 * max(m, n) * eps * norm)
+                    report("qr reconstruction", "double", m, n, -1, -1);
+                if (orthogonalityError(q, r) > 16 * max(m, n) * eps)
+                    report("qr orthogonality", "double", m, n, -2, -2);
+                for (int i = 0; i < r; ++i)
+                    for (int j = 0; j < i; ++j)
+                        if (rf[i][j] != 0)
+                            report("qr triangle", "double", m, n, i, j);
+
+                // Tall random matrices have full column rank with probability one
+                if (m < n || m < 2 * n)
+                    continue;
+                vector<double> b(m);
+                for (int i = 0; i < m; ++i)
+                    b[i] = randomMatrix<double>(1, 1, rng)[0][0];
+                vector<double> x = qr.leastSquares(b);
+                vector<long double> ref = referenceLeastSquares(a, b);
+                for (int i = 0; i < n; ++i)
+                    if (fabsl(x[i] - ref[i]) > 1024 * m * eps * max(fabsl(ref[i]), 1.0L))
+                        report("qr leastSquares", "double", m, n, i, 0);
+            }
+        }
+    }
+}
+
+// Every placement and pinning policy must produce bit-identical products,
+// since they only change which thread touches which row
+void testPlacement(mt19937_64 &rng)
+{
+    setDefaultThreads(4);
+    Matrix<double> a = randomMatrix<double>(700, 400, rng);
+    Matrix<double> b = randomMatrix<double>(400, 500, rng);
+    Matrix<double> expected = a * b;
+    for (Placement place : {Placement::FirstTouch, Placement::Interleave, Placement::Caller})
+    {
+        for (Pinning pin : {Pinning::None, Pinning::Compact, Pinning::Scatter})
+        {
+            setPlacement(place);
+            setPinning(pin);
+            Matrix<double> x = a + Matrix<double>(700, 400);
+            Matrix<double> c = x * b;
+            if (maxAbsDifference(c, expected) != 0 || sum(x) != sum(a))
+                report("placement", "double", 700, 500, static_cast<int>(place), static_cast<int>(pin));
+        }
+    }
+    setPlacement(Placement::FirstTouch);
+    setPinning(Pinning::None);
+    setDefaultThreads(0);
+}
+
+template <typename T>
+void testTextIO(mt19937_64 &rng, int trials)
+{
+    // Values over a wide range of magnitudes for floating point types
+    uniform_int_distribution<int> dim(1, 300), exponent(-30, 30), precision(0, 8);
+    for (int threads : threadCounts)
+    {
+        for (int t = 0; t < trials; ++t)
+        {
+            int r = dim(rng), c = dim(rng);
+            Matrix<T> a = randomMatrix<T>(r, c, rng);
+            if constexpr (is_floating_point_v<T>)
+                for (int i = 0; i < r; ++i)
+                    for (int j = 0; j < c; ++j)
+                        a[i][j] = static_cast<T>(a[i][j] * pow(10.0, exponent(rng)));
+
+            // Round-trip output must read back bit for bit in every format
+            for (TextFormat format : {TextFormat::Plain, TextFormat::Csv, TextFormat::MatrixMarket})
+            {
+                string text = formatMatrix(a, {format, roundTripPrecision, threads});
+                Matrix<T> b = format == TextFormat::Plain ? parseMatrix<T>(text, r, c, threads)
+                              : format == TextFormat::Csv ? parseCsv<T>(text, threads)
+                                                          : parseMatrixMarket<T>(text, threads);
+                if (b.rows() != r || b.cols() != c || maxAbsDifference(a, b) != 0)
+                    report("text round trip", typeName<T>(), r, c, static_cast<int>(format), 0);
+            }
+
+            // Fixed precision output must match the iostream formatting it replaces
+            int p = precision(rng);
+            ostringstream expected;
+            for (int i = 0; i < r; ++i)
+            {
+                for (int j = 0; j < c; ++j)
+                    expected << fixed << setprecision(p) << a[i][j] << " ";
+                expected << "\n";
+            }
+            if (formatMatrix(a, {TextFormat::Plain, p, threads}) != expected.str())
+                report("fixed precision output", typeName<T>(), r, c, p, 0);
+        }
+    }
+}
+
+template <typename T>
+void runAll(mt19937_64 &rng)
+{
+    testElementwise<T>(rng, 50);
+    testMultiply<T>(rng, 50);
+    testPower<T>(rng, 20);
+    testDeterminant<T>(rng, 50);
+    testReductions<T>(rng, 4);
+    testTextIO<T>(rng, 2);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        seed = strtoull(argv[1], nullptr, 10);
+    mt19937_64 rng(seed);
+
+    runAll<int>(rng);
+    runAll<float>(rng);
+    runAll<double>(rng);
+    testSymmetricEigen(rng, 2);
+    testGeneralEigenvalues(rng, 3);
+    testSVD(rng, 2);
+    testCholesky(rng, 2);
+    testQR(rng, 3);
+    testPlacement(rng);
+
+    if (failures)
+    {
+        cerr << failures << " differential checks failed" << endl;
+        return 1;
+    }
+    cout << "All differential tests passed! (seed " << seed << ")" << endl;
+    return 0;
+}
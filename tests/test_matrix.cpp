@@ -1,7 +1,14 @@
 #include <iostream>
 #include <vector>
 #include <cassert>  // for assert
-#include "../src/Matrix.cpp" // assuming Matrix class is declared in Matrix.h
+#include <climits>
+#include "../src/Matrix.hpp"
+#include "../src/Reductions.hpp"
+#include "../src/Spectral.hpp"
+#include "../src/Factorizations.hpp"
+#include "../src/MatrixIO.hpp"
+#include <sstream>
+#include <iomanip>
 
 using namespace std;
 
@@ -93,6 +100,219 @@ void testMatrixPower()
     assert(power_result[1][0] == 15 && power_result[1][1] == 22);
 }
 
+void testReductions()
+{
+    // Test sums, extrema, trace and norms
+    Matrix<double> mat({{1, -2}, {3, 4}});
+    assert(sum(mat) == 6);
+    assert(minElement(mat) == -2 && maxElement(mat) == 4);
+    assert(trace(mat) == 5);
+    assert(norm1(mat) == 6);
+    assert(normInf(mat) == 7);
+    assert(frobeniusNorm(mat) == sqrt(30.0));
+
+    // Test that the Frobenius norm neither overflows nor loses NaNs
+    Matrix<double> huge({{3e200, 4e200}}), nan({{0, NAN}, {1e-200, 0}});
+    assert(fabs(frobeniusNorm(huge) / 5e200 - 1) < 1e-15);
+    assert(isnan(frobeniusNorm(nan)));
+
+    // Test norms of the most negative integer
+    Matrix<int> extreme({{INT_MIN, 1}});
+    assert(normInf(extreme) == 2147483649.0 && norm1(extreme) == 2147483648.0);
+    assert(frobeniusNorm(extreme) == sqrt(2147483648.0 * 2147483648.0 + 1));
+
+    // Test row-wise and column-wise reductions
+    vector<double> rs = rowSums(mat), cs = colSums(mat);
+    assert(rs[0] == -1 && rs[1] == 7);
+    assert(cs[0] == 4 && cs[1] == 2);
+    assert(rowMins(mat)[0] == -2 && rowMaxs(mat)[1] == 4);
+    assert(colMins(mat)[1] == -2 && colMaxs(mat)[0] == 3);
+}
+
+void testSpectral()
+{
+    // Test symmetric eigenvalues and eigenvectors
+    Matrix<double> sym({{2, 1}, {1, 2}});
+    SymmetricEigen eig = symmetricEigen(sym);
+    assert(fabs(eig.values[0] - 1) < 1e-12 && fabs(eig.values[1] - 3) < 1e-12);
+    assert(fabs(fabs(eig.vectors[0][1]) - sqrt(0.5)) < 1e-12);
+
+    // Test general eigenvalues (a rotation has eigenvalues +-i)
+    Matrix<double> rotation({{0, -1}, {1, 0}});
+    vector<complex<double>> values = eigenvalues(rotation);
+    assert(abs(values[0] - complex<double>(0, -1)) < 1e-12);
+    assert(abs(values[1] - complex<double>(0, 1)) < 1e-12);
+
+    // Test singular values
+    Matrix<double> mat({{3, 0}, {0, -4}, {0, 0}});
+    SVD d = svd(mat);
+    assert(fabs(d.S[0] - 4) < 1e-12 && fabs(d.S[1] - 3) < 1e-12);
+    assert(d.U.rows() == 3 && d.U.cols() == 2 && d.V.rows() == 2);
+}
+
+void testFactorizations()
+{
+    // Test Cholesky factor and solve
+    Matrix<double> spd({{4, 2}, {2, 3}});
+    Cholesky chol(spd);
+    Matrix<double> l = chol.L();
+    assert(l[0][0] == 2 && l[1][0] == 1 && l[0][1] == 0);
+    assert(fabs(l[1][1] - sqrt(2.0)) < 1e-12);
+    vector<double> x = chol.solve(vector<double>{6, 5});
+    assert(fabs(x[0] - 1) < 1e-12 && fabs(x[1] - 1) < 1e-12);
+    assert(fabs(chol.determinant() - 8) < 1e-12);
+
+    // Test QR least squares: fit y = 1 + 2t through exact data
+    Matrix<double> design({{1, 0}, {1, 1}, {1, 2}});
+    QR qr(design);
+    vector<double> coef = qr.leastSquares(vector<double>{1, 3, 5});
+    assert(fabs(coef[0] - 1) < 1e-12 && fabs(coef[1] - 2) < 1e-12);
+    Matrix<double> r = qr.R();
+    assert(r.rows() == 2 && r[1][0] == 0);
+}
+
+void testNuma()
+{
+    // Test sysfs list parsing and topology detection
+    vector<int> cpus = numa_detail::parseCpuList("0-2,5,8-9\n");
+    assert((cpus == vector<int>{0, 1, 2, 5, 8, 9}));
+    const NumaTopology &topology = numaTopology();
+    assert(topology.nodes() >= 1 && !topology.nodeCpus[0].empty());
+    assert(workerCpu(0, Pinning::None) == -1);
+    assert(workerCpu(0, Pinning::Compact) == topology.nodeCpus[0][0]);
+
+    // Test that placed allocation zero-initializes every row
+    setPlacement(Placement::Interleave);
+    Matrix<double> mat(1024, 512);
+    setPlacement(Placement::FirstTouch);
+    assert(mat.rows() == 1024 && mat.cols() == 512);
+    assert(mat[1023][511] == 0 && mat[1][0] == 0);
+    setPinning(Pinning::Compact);
+    Matrix<double> touched(1024, 512);
+    setPinning(Pinning::None);
+    assert(touched[1023][511] == 0 && touched[512][0] == 0);
+}
+
+void testTextIO()
+{
+    // Test output formats and precision
+    Matrix<double> mat({{1.5, -2}, {3.25, 0.1}});
+    ostringstream plain;
+    plain << mat;
+    assert(plain.str() == "1.50 -2.00 \n3.25 0.10 \n");
+    // Wide types are formatted in full, as iostreams do
+    ostringstream wide, expectedWide;
+    wide << Matrix<long double>({{1e400L, 2}});
+    expectedWide << fixed << setprecision(2) << 1e400L << " " << 2.0L << " \n";
+    assert(wide.str() == expectedWide.str());
+    assert(formatMatrix(Matrix<double>(vector<vector<double>>{{1.0 / 3}}), {TextFormat::Plain, 100}).size() == 104);
+
+    // bool and character matrices keep the iostream formatting
+    ostringstream flags, chars;
+    flags << Matrix<bool>({{true, false}});
+    chars << Matrix<char>({{'a', 'b'}});
+    assert(flags.str() == "1 0 \n" && chars.str() == "a b \n");
+    assert(formatMatrix(mat, {TextFormat::Csv, 1}) == "1.5,-2.0\n3.2,0.1\n");
+    assert(formatMatrix(mat, {TextFormat::Plain, roundTripPrecision}) == "1.5 -2 \n3.25 0.1 \n");
+    assert(formatMatrix(mat, {TextFormat::MatrixMarket, roundTripPrecision}) ==
+           "%%MatrixMarket matrix array real general\n2 2\n1.5\n3.25\n-2\n0.1\n");
+
+    // Test parsing plain, CSV and Matrix Market text
+    Matrix<int> parsed = parseMatrix<int>(" 1 2\n3\t+4\n", 2, 2);
+    assert(parsed[0][1] == 2 && parsed[1][1] == 4);
+    Matrix<double> csv = parseCsv<double>("1,2,3\r\n4,5,6\r\n");
+    assert(csv.rows() == 2 && csv.cols() == 3 && csv[1][2] == 6);
+    Matrix<double> array = parseMatrixMarket<double>("%%MatrixMarket matrix array real general\n% comment\n2 2\n1\n2\n3\n4\n");
+    assert(array[1][0] == 2 && array[0][1] == 3);
+    Matrix<double> coord = parseMatrixMarket<double>("%%MatrixMarket matrix coordinate real symmetric\n3 3 2\n1 1 5\n3 1 -1.5\n");
+    assert(coord[0][0] == 5 && coord[2][0] == -1.5 && coord[0][2] == -1.5 && coord[1][1] == 0);
+
+    // Test that reading from a stream stops after the last element
+    istringstream in("1 2\n3 4 7");
+    Matrix<double> read = readMatrix<double>(in, 2, 2);
+    int next;
+    in >> next;
+    assert(read[1][1] == 4 && next == 7);
+
+    // Test error reporting
+    bool threw = false;
+    try
+    {
+        parseMatrix<double>("1 2 x 4", 2, 2);
+    }
+    catch (const runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    for (const char *bad : {"1 2 +-3 4", "1 2 +-inf 4", "1 2 ++3 4"})
+    {
+        threw = false;
+        try
+        {
+            parseMatrix<double>(bad, 2, 2);
+        }
+        catch (const runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+        threw = false;
+        try
+        {
+            parseMatrix<int>(bad, 2, 2);
+        }
+        catch (const runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+    threw = false;
+    try
+    {
+        parseMatrix<double>("1 2 3", 2, 2);
+    }
+    catch (const runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // Test that ragged CSV rows and empty CSV fields are rejected
+    for (const char *bad : {"1,2,3\n4,5\n6,7,8,9\n", "1,,3\n4,5,6\n", "1,2,\n"})
+    {
+        threw = false;
+        try
+        {
+            parseCsv<double>(bad);
+        }
+        catch (const runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Test that Matrix Market size lines are checked before allocating
+    for (const char *bad : {"%%MatrixMarket matrix coordinate real general\n2 2 99999999999999\n1 1 1\n",
+                            "%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1\n",
+                            "%%MatrixMarket matrix coordinate real general\n3000000000 1 0\n",
+                            "%%MatrixMarket matrix array real general\n100000 100000\n1\n"})
+    {
+        threw = false;
+        try
+        {
+            parseMatrixMarket<double>(bad);
+        }
+        catch (const runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
 int main()
 {
     // Run tests
@@ -103,6 +323,11 @@ int main()
     testScalarMultiplication();
     testIdentityMatrix();
     testMatrixPower();
+    testReductions();
+    testSpectral();
+    testFactorizations();
+    testNuma();
+    testTextIO();
 
     cout << "All tests passed!" << endl;
     return 0;